@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#if defined(_MSC_VER)
+#include <malloc.h>
+#endif
+
+
+namespace mosqp
+{
+
+// Allocator for standard containers whose memory starts at a multiple of "ALIGNMENT" bytes,
+// e.g. a cache line, which C++14 "new" does not promise beyond the alignment of the type.
+template <typename T, size_t ALIGNMENT>
+class AlignedAllocator
+{
+public:
+    using value_type = T;
+
+    template <typename U>
+    struct rebind
+    {
+        using other = AlignedAllocator<U, ALIGNMENT>;
+    };
+
+    AlignedAllocator() = default;
+
+    template <typename U>
+    AlignedAllocator(AlignedAllocator<U, ALIGNMENT> const &)
+    {
+    }
+
+    T * allocate(size_t const size)
+    {
+        if (size == 0)
+        {
+            return nullptr;
+        }
+
+        void *memory = nullptr;
+#if defined(_MSC_VER)
+        memory = _aligned_malloc(size * sizeof(T), ALIGNMENT);
+#else
+        if (posix_memalign(&memory, ALIGNMENT, size * sizeof(T)) != 0)
+        {
+            memory = nullptr;
+        }
+#endif
+        if (memory == nullptr)
+        {
+            throw std::bad_alloc();
+        }
+        return static_cast<T *>(memory);
+    }
+
+    void deallocate(T *const memory, size_t)
+    {
+#if defined(_MSC_VER)
+        _aligned_free(memory);
+#else
+        std::free(memory);
+#endif
+    }
+
+    template <typename U>
+    bool operator==(AlignedAllocator<U, ALIGNMENT> const &) const
+    {
+        return true;
+    }
+
+    template <typename U>
+    bool operator!=(AlignedAllocator<U, ALIGNMENT> const &) const
+    {
+        return false;
+    }
+};
+
+} // namespace mosqp
@@ -0,0 +1,64 @@
+#include "ArrayView.hpp"
+#include <cstddef>
+#include <vector>
+
+
+namespace mosqp
+{
+
+ArrayView::ArrayView(double const *const data, size_t const size)
+    : first(data), length(size)
+{
+}
+
+ArrayView::ArrayView(std::vector<double> const &vector)
+    : first(vector.data()), length(vector.size())
+{
+}
+
+double const * ArrayView::data() const
+{
+    return first;
+}
+
+size_t ArrayView::size() const
+{
+    return length;
+}
+
+bool ArrayView::empty() const
+{
+    return length == 0;
+}
+
+double ArrayView::operator[](size_t const index) const
+{
+    return first[index];
+}
+
+double const * ArrayView::begin() const
+{
+    return first;
+}
+
+double const * ArrayView::end() const
+{
+    return first + length;
+}
+
+double const * ArrayView::cbegin() const
+{
+    return first;
+}
+
+double const * ArrayView::cend() const
+{
+    return first + length;
+}
+
+std::vector<double> ArrayView::ToVector() const
+{
+    return std::vector<double>(first, first + length);
+}
+
+} // namespace mosqp
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+
+namespace mosqp
+{
+
+// Read-only view of a contiguous array of doubles owned by someone else, e.g. one of the
+// arrays stored in the memory block of a "Point".
+class ArrayView
+{
+public:
+    ArrayView(double const *data, size_t size);
+    // Views the contents of the vector, which must not change while the view is used.
+    ArrayView(std::vector<double> const &vector);
+
+    double const * data() const;
+    size_t size() const;
+    bool empty() const;
+    double operator[](size_t index) const;
+
+    double const * begin() const;
+    double const * end() const;
+    double const * cbegin() const;
+    double const * cend() const;
+
+    std::vector<double> ToVector() const;
+
+private:
+    double const *first;
+    size_t length;
+};
+
+} // namespace mosqp
@@ -0,0 +1,114 @@
+#include "BiObjectiveArchive.hpp"
+#include "DominanceArchive.hpp"
+#include "LinearArchive.hpp"
+#include "Point.hpp"
+#include <cstddef>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <vector>
+
+
+namespace mosqp
+{
+
+BiObjectiveArchive::BiObjectiveArchive()
+    : tolerance(Point::TOL_FEAS), others(2)
+{
+}
+
+std::unique_ptr<DominanceArchive> BiObjectiveArchive::Clone() const
+{
+    return std::make_unique<BiObjectiveArchive>(*this);
+}
+
+void BiObjectiveArchive::Insert(size_t const slot, Point const &point)
+{
+    double const f1 = point.GetObjectiveValue(0);
+    double const f2 = point.GetObjectiveValue(1);
+    if (point.GetMaxViolation() <= tolerance)
+    {
+        // the point fits if it is strictly between its neighbours in both objectives
+        auto const next = staircase.lower_bound(f1);
+        bool const fits_next = (next == staircase.end() || (next->first > f1 && next->second.f2 < f2));
+        bool const fits_prev = (next == staircase.begin() || std::prev(next)->second.f2 > f2);
+        if (fits_next && fits_prev)
+        {
+            staircase.emplace_hint(next, f1, Step{ f2, point.GetMaxViolation(), slot });
+            return;
+        }
+    }
+
+    others.Insert(slot, point);
+}
+
+void BiObjectiveArchive::Remove(size_t const slot, Point const &point)
+{
+    auto const step = staircase.find(point.GetObjectiveValue(0));
+    if (step != staircase.end() && step->second.slot == slot)
+    {
+        staircase.erase(step);
+    }
+    else
+    {
+        others.Remove(slot, point);
+    }
+}
+
+void BiObjectiveArchive::Clear()
+{
+    tolerance = Point::TOL_FEAS;
+    staircase.clear();
+    others.Clear();
+}
+
+bool BiObjectiveArchive::IsDominated(Point const &point) const
+{
+    // the step with the largest f1 not greater than the point's f1 has the smallest f2 of all
+    // steps that could dominate the point
+    double const f2 = point.GetObjectiveValue(1);
+    auto const next = staircase.upper_bound(point.GetObjectiveValue(0));
+    if (Point::TOL_FEAS >= tolerance)
+    {
+        if (next != staircase.begin() && std::prev(next)->second.f2 <= f2)
+        {
+            return true;
+        }
+    }
+    else
+    {
+        // the steps dominating the point in the objectives are those right before "next" that
+        // are not above it, but each of them may fail the violation part now
+        double const max_violation = point.GetMaxViolation();
+        for (auto step = next; step != staircase.begin() && std::prev(step)->second.f2 <= f2; --step)
+        {
+            if (!(max_violation < std::prev(step)->second.maxViolation - Point::TOL_FEAS))
+            {
+                return true;
+            }
+        }
+    }
+
+    return others.IsDominated(point);
+}
+
+void BiObjectiveArchive::FindDominated(Point const &point, std::vector<size_t> &slots) const
+{
+    double const f1 = point.GetObjectiveValue(0);
+    double const f2 = point.GetObjectiveValue(1);
+    double const max_violation = point.GetMaxViolation();
+    bool const feasible = point.IsFeasible();
+
+    // all steps from f1 onwards are dominated in the objectives until f2 drops below the point's
+    for (auto step = staircase.lower_bound(f1); step != staircase.end() && step->second.f2 >= f2; ++step)
+    {
+        if (feasible || step->second.maxViolation >= max_violation - Point::TOL_FEAS)
+        {
+            slots.push_back(step->second.slot);
+        }
+    }
+
+    others.FindDominated(point, slots);
+}
+
+} // namespace mosqp
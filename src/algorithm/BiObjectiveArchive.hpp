@@ -0,0 +1,56 @@
+#pragma once
+
+#include "DominanceArchive.hpp"
+#include "LinearArchive.hpp"
+#include "Point.hpp"
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <vector>
+
+
+namespace mosqp
+{
+
+// Archive for problems with exactly two objectives.
+// Feasible points never fail the violation part of "Point::IsDominated", so among them
+// dominance only depends on the objective-values. Mutually non-dominated feasible points form
+// a staircase: sorted ascending by f1 they are sorted strictly descending by f2. Whether a point
+// is dominated by a point of the staircase is then decided by a single binary search, and the
+// points it dominates are a contiguous range of the staircase.
+// Infeasible points, and feasible points that don't fit onto the staircase (which can only
+// happen when inserting without checking domination), are kept in a linear archive.
+// Feasibility is decided with the value "Point::TOL_FEAS" had when the archive was created or
+// cleared. If the tolerance is lowered afterwards, points on the staircase may fail the violation
+// part, and the queries check the steps one by one instead.
+class BiObjectiveArchive : public DominanceArchive
+{
+public:
+    BiObjectiveArchive();
+
+    std::unique_ptr<DominanceArchive> Clone() const override;
+
+    void Insert(size_t slot, Point const &point) override;
+    void Remove(size_t slot, Point const &point) override;
+    void Clear() override;
+
+    bool IsDominated(Point const &point) const override;
+    void FindDominated(Point const &point, std::vector<size_t> &slots) const override;
+
+private:
+    struct Step
+    {
+        double f2;
+        double maxViolation;
+        size_t slot;
+    };
+
+    // The tolerance the points on the staircase were classified as feasible with.
+    double tolerance;
+    // The feasible points, keyed by their first objective-value.
+    std::map<double, Step> staircase;
+    // All points that are not on the staircase.
+    LinearArchive others;
+};
+
+} // namespace mosqp
@@ -0,0 +1,65 @@
+#include "BlockPool.hpp"
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+
+namespace mosqp
+{
+
+// Returns the blocks to the heap when the thread ends.
+struct FreeBlocks
+{
+    std::unordered_map<size_t, std::vector<double *>> bySize;
+
+    ~FreeBlocks()
+    {
+        for (auto &entry : bySize)
+        {
+            for (double *block : entry.second)
+            {
+                delete[] block;
+            }
+        }
+    }
+};
+
+static thread_local FreeBlocks free_blocks;
+
+double * BlockPool::Allocate(size_t const size)
+{
+    if (size == 0)
+    {
+        return nullptr;
+    }
+
+    std::vector<double *> &blocks = free_blocks.bySize[size];
+    if (blocks.empty())
+    {
+        return new double[size];
+    }
+
+    double *const block = blocks.back();
+    blocks.pop_back();
+    return block;
+}
+
+void BlockPool::Free(double *const block, size_t const size)
+{
+    if (block == nullptr)
+    {
+        return;
+    }
+
+    std::vector<double *> &blocks = free_blocks.bySize[size];
+    if (blocks.size() < MAX_FREE_BLOCKS)
+    {
+        blocks.push_back(block);
+    }
+    else
+    {
+        delete[] block;
+    }
+}
+
+} // namespace mosqp
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstddef>
+
+
+namespace mosqp
+{
+
+// Hands out blocks of doubles and keeps freed blocks for reuse, sorted by their size.
+// Points of one problem all need blocks of the same few sizes, so after the first iterations
+// creating and destroying points rarely reaches the heap. Every thread has its own pool, a
+// block freed on another thread than it was allocated on simply moves to that thread's pool.
+class BlockPool
+{
+public:
+    static double * Allocate(size_t size);
+    static void Free(double *block, size_t size);
+
+private:
+    // Freed blocks kept per size, any further ones are returned to the heap.
+    static size_t const MAX_FREE_BLOCKS = 4096;
+};
+
+} // namespace mosqp
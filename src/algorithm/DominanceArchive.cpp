@@ -0,0 +1,11 @@
+#include "DominanceArchive.hpp"
+
+
+namespace mosqp
+{
+
+DominanceArchive::~DominanceArchive()
+{
+}
+
+} // namespace mosqp
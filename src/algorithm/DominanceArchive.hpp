@@ -0,0 +1,34 @@
+#pragma once
+
+#include "Point.hpp"
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+
+namespace mosqp
+{
+
+// Answers the dominance queries "ParetoFront" needs when inserting a point. The archive
+// mirrors the points of the front, each of them identified by its slot in the front.
+// Dominance is meant as in "Point::IsDominated".
+class DominanceArchive
+{
+public:
+    virtual ~DominanceArchive();
+
+    // Creates a copy of this archive, needed to copy the owning "ParetoFront".
+    virtual std::unique_ptr<DominanceArchive> Clone() const = 0;
+
+    virtual void Insert(size_t slot, Point const &point) = 0;
+    // The given point has to be the one that was inserted with this slot.
+    virtual void Remove(size_t slot, Point const &point) = 0;
+    virtual void Clear() = 0;
+
+    // Whether the given point is dominated by any point in the archive.
+    virtual bool IsDominated(Point const &point) const = 0;
+    // Appends the slots of all points in the archive that are dominated by the given point.
+    virtual void FindDominated(Point const &point, std::vector<size_t> &slots) const = 0;
+};
+
+} // namespace mosqp
@@ -0,0 +1,166 @@
+#include "DominanceKernels.hpp"
+#include "DominanceKernelsSimd.hpp"
+#include "Point.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+#if defined(MOSQP_SIMD_KERNELS) && defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+
+namespace mosqp
+{
+
+// Whether the i-th point dominates the point with "f" and "max_violation", written out
+// like "Point::IsDominated" so that both agree exactly.
+static bool Dominates(double const *values, size_t const stride, double const *max_violations, size_t const i,
+                      size_t const num_objectives, double const *f, double const max_violation)
+{
+    for (size_t k = 0; k < num_objectives; k += 1)
+    {
+        if (f[k] < values[k * stride + i])
+        {
+            return false;
+        }
+    }
+    return !(max_violation < max_violations[i] - Point::TOL_FEAS);
+}
+
+// Whether the i-th point is dominated by the point with "f" and "max_violation".
+static bool IsDominatedBy(double const *values, size_t const stride, double const *max_violations, size_t const i,
+                          size_t const num_objectives, double const *f, double const max_violation)
+{
+    for (size_t k = 0; k < num_objectives; k += 1)
+    {
+        if (values[k * stride + i] < f[k])
+        {
+            return false;
+        }
+    }
+    return !(max_violations[i] < max_violation - Point::TOL_FEAS);
+}
+
+// The best instruction set that the CPU and the operating system support. This file is built
+// without any of them, so checking here cannot run into one of their instructions itself.
+enum class InstructionSet
+{
+    Scalar,
+    Avx2,
+    Avx512
+};
+
+static InstructionSet CheckInstructionSet()
+{
+#if defined(MOSQP_SIMD_KERNELS) && defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7)
+    {
+        return InstructionSet::Scalar;
+    }
+    // the CPU has to support AVX and the operating system has to save the YMM registers
+    __cpuid(info, 1);
+    bool const has_osxsave = (info[2] & (1 << 27)) != 0;
+    bool const has_avx = (info[2] & (1 << 28)) != 0;
+    if (!has_osxsave || !has_avx || (_xgetbv(0) & 0x6) != 0x6)
+    {
+        return InstructionSet::Scalar;
+    }
+    __cpuidex(info, 7, 0);
+    // for AVX-512 it also has to save the opmask and ZMM registers
+    if ((info[1] & (1 << 16)) != 0 && (_xgetbv(0) & 0xe6) == 0xe6)
+    {
+        return InstructionSet::Avx512;
+    }
+    return ((info[1] & (1 << 5)) != 0) ? InstructionSet::Avx2 : InstructionSet::Scalar;
+#elif defined(MOSQP_SIMD_KERNELS)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f"))
+    {
+        return InstructionSet::Avx512;
+    }
+    return __builtin_cpu_supports("avx2") ? InstructionSet::Avx2 : InstructionSet::Scalar;
+#else
+    return InstructionSet::Scalar;
+#endif
+}
+
+static InstructionSet GetInstructionSet()
+{
+    static InstructionSet const instruction_set = CheckInstructionSet();
+    return instruction_set;
+}
+
+bool AnyDominates(double const *values, size_t const stride, double const *max_violations, size_t const num_points,
+                  size_t const num_objectives, double const *f, double const max_violation)
+{
+    size_t i = 0;
+#if defined(MOSQP_SIMD_KERNELS)
+    InstructionSet const instruction_set = GetInstructionSet();
+    if (instruction_set == InstructionSet::Avx512)
+    {
+        if (AnyDominatesAvx512(values, stride, max_violations, num_points, num_objectives, f, max_violation))
+        {
+            return true;
+        }
+        i = num_points - num_points % AVX512_BLOCK_SIZE;
+    }
+    else if (instruction_set == InstructionSet::Avx2)
+    {
+        if (AnyDominatesAvx2(values, stride, max_violations, num_points, num_objectives, f, max_violation))
+        {
+            return true;
+        }
+        i = num_points - num_points % AVX2_BLOCK_SIZE;
+    }
+#endif
+
+    for (; i < num_points; i += 1)
+    {
+        if (Dominates(values, stride, max_violations, i, num_objectives, f, max_violation))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void FindDominatedIndices(double const *values, size_t const stride, double const *max_violations,
+                          size_t const num_points, size_t const num_objectives, double const *f,
+                          double const max_violation, std::vector<size_t> &indices)
+{
+    size_t i = 0;
+#if defined(MOSQP_SIMD_KERNELS)
+    InstructionSet const instruction_set = GetInstructionSet();
+    if (instruction_set != InstructionSet::Scalar)
+    {
+        // the kernels write into a buffer on the stack, a chunk of points at a time
+        size_t constexpr CHUNK_SIZE = 256;
+        size_t chunk_indices[CHUNK_SIZE];
+        size_t const block_size = (instruction_set == InstructionSet::Avx512) ? AVX512_BLOCK_SIZE : AVX2_BLOCK_SIZE;
+        size_t const num_blocked = num_points - num_points % block_size;
+        for (; i < num_blocked; i += CHUNK_SIZE)
+        {
+            size_t const last = std::min(i + CHUNK_SIZE, num_blocked);
+            size_t const num_dominated = (instruction_set == InstructionSet::Avx512)
+                ? FindDominatedIndicesAvx512(values, stride, max_violations, i, last, num_objectives, f,
+                                             max_violation, chunk_indices)
+                : FindDominatedIndicesAvx2(values, stride, max_violations, i, last, num_objectives, f,
+                                           max_violation, chunk_indices);
+            indices.insert(indices.end(), chunk_indices, chunk_indices + num_dominated);
+        }
+        i = num_blocked;
+    }
+#endif
+
+    for (; i < num_points; i += 1)
+    {
+        if (IsDominatedBy(values, stride, max_violations, i, num_objectives, f, max_violation))
+        {
+            indices.push_back(i);
+        }
+    }
+}
+
+} // namespace mosqp
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+
+namespace mosqp
+{
+
+// Dominance tests of one point against many, as in "Point::IsDominated". The many points are
+// given per objective: "values[k * stride + i]" is the k-th objective-value of the i-th point.
+// Uses AVX-512 or AVX2 to test eight or four points at once if the CPU supports it, plain loops
+// otherwise.
+
+// Whether any of the points dominates the point with "f" and "max_violation".
+bool AnyDominates(double const *values, size_t stride, double const *max_violations, size_t num_points,
+                  size_t num_objectives, double const *f, double max_violation);
+
+// Appends the indices of all points that are dominated by the point with "f" and "max_violation".
+void FindDominatedIndices(double const *values, size_t stride, double const *max_violations, size_t num_points,
+                          size_t num_objectives, double const *f, double max_violation,
+                          std::vector<size_t> &indices);
+
+} // namespace mosqp
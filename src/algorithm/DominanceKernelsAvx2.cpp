@@ -0,0 +1,80 @@
+#include "DominanceKernelsSimd.hpp"
+#include <cstddef>
+#if defined(MOSQP_SIMD_KERNELS)
+#include <immintrin.h>
+#endif
+
+// MSVC builds this file with /arch:AVX2 (see the project), GCC and Clang get the target here.
+#if defined(MOSQP_SIMD_KERNELS) && !defined(_MSC_VER)
+#define MOSQP_SIMD_TARGET __attribute__((target("avx2")))
+#else
+#define MOSQP_SIMD_TARGET
+#endif
+
+#if defined(MOSQP_SIMD_KERNELS)
+#include "DominanceKernelsBlocked.hpp"
+#endif
+
+
+namespace mosqp
+{
+
+#if defined(MOSQP_SIMD_KERNELS)
+// Four doubles per vector, the masks are vectors as well.
+struct Avx2
+{
+    using Vector = __m256d;
+    using Mask = __m256d;
+    static size_t constexpr BLOCK_SIZE = AVX2_BLOCK_SIZE;
+
+    MOSQP_SIMD_TARGET static Vector Load(double const *values)
+    {
+        return _mm256_loadu_pd(values);
+    }
+
+    MOSQP_SIMD_TARGET static Vector Broadcast(double const value)
+    {
+        return _mm256_set1_pd(value);
+    }
+
+    MOSQP_SIMD_TARGET static Vector Subtract(Vector const a, Vector const b)
+    {
+        return _mm256_sub_pd(a, b);
+    }
+
+    MOSQP_SIMD_TARGET static Mask NotLess(Vector const a, Vector const b)
+    {
+        return _mm256_cmp_pd(a, b, _CMP_NLT_UQ);
+    }
+
+    MOSQP_SIMD_TARGET static Mask NotLess(Mask const mask, Vector const a, Vector const b)
+    {
+        return _mm256_and_pd(mask, _mm256_cmp_pd(a, b, _CMP_NLT_UQ));
+    }
+
+    MOSQP_SIMD_TARGET static unsigned int GetBits(Mask const mask)
+    {
+        return static_cast<unsigned int>(_mm256_movemask_pd(mask));
+    }
+};
+
+MOSQP_SIMD_TARGET
+bool AnyDominatesAvx2(double const *values, size_t const stride, double const *max_violations,
+                      size_t const num_points, size_t const num_objectives, double const *f,
+                      double const max_violation)
+{
+    return AnyDominatesBlocked<Avx2>(values, stride, max_violations, num_points, num_objectives, f,
+                                     max_violation);
+}
+
+MOSQP_SIMD_TARGET
+size_t FindDominatedIndicesAvx2(double const *values, size_t const stride, double const *max_violations,
+                                size_t const first, size_t const last, size_t const num_objectives,
+                                double const *f, double const max_violation, size_t *const indices)
+{
+    return FindDominatedIndicesBlocked<Avx2>(values, stride, max_violations, first, last, num_objectives, f,
+                                             max_violation, indices);
+}
+#endif
+
+} // namespace mosqp
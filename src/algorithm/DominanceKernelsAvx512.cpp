@@ -0,0 +1,81 @@
+#include "DominanceKernelsSimd.hpp"
+#include <cstddef>
+#if defined(MOSQP_SIMD_KERNELS)
+#include <immintrin.h>
+#endif
+
+// MSVC builds this file with /arch:AVX512 (see the project), GCC and Clang get the target here.
+#if defined(MOSQP_SIMD_KERNELS) && !defined(_MSC_VER)
+#define MOSQP_SIMD_TARGET __attribute__((target("avx512f")))
+#else
+#define MOSQP_SIMD_TARGET
+#endif
+
+#if defined(MOSQP_SIMD_KERNELS)
+#include "DominanceKernelsBlocked.hpp"
+#endif
+
+
+namespace mosqp
+{
+
+#if defined(MOSQP_SIMD_KERNELS)
+// Eight doubles per vector, the masks are opmask registers, so comparing with a mask skips the
+// lanes outside of it instead of combining the results.
+struct Avx512
+{
+    using Vector = __m512d;
+    using Mask = __mmask8;
+    static size_t constexpr BLOCK_SIZE = AVX512_BLOCK_SIZE;
+
+    MOSQP_SIMD_TARGET static Vector Load(double const *values)
+    {
+        return _mm512_loadu_pd(values);
+    }
+
+    MOSQP_SIMD_TARGET static Vector Broadcast(double const value)
+    {
+        return _mm512_set1_pd(value);
+    }
+
+    MOSQP_SIMD_TARGET static Vector Subtract(Vector const a, Vector const b)
+    {
+        return _mm512_sub_pd(a, b);
+    }
+
+    MOSQP_SIMD_TARGET static Mask NotLess(Vector const a, Vector const b)
+    {
+        return _mm512_cmp_pd_mask(a, b, _CMP_NLT_UQ);
+    }
+
+    MOSQP_SIMD_TARGET static Mask NotLess(Mask const mask, Vector const a, Vector const b)
+    {
+        return _mm512_mask_cmp_pd_mask(mask, a, b, _CMP_NLT_UQ);
+    }
+
+    MOSQP_SIMD_TARGET static unsigned int GetBits(Mask const mask)
+    {
+        return mask;
+    }
+};
+
+MOSQP_SIMD_TARGET
+bool AnyDominatesAvx512(double const *values, size_t const stride, double const *max_violations,
+                        size_t const num_points, size_t const num_objectives, double const *f,
+                        double const max_violation)
+{
+    return AnyDominatesBlocked<Avx512>(values, stride, max_violations, num_points, num_objectives, f,
+                                       max_violation);
+}
+
+MOSQP_SIMD_TARGET
+size_t FindDominatedIndicesAvx512(double const *values, size_t const stride, double const *max_violations,
+                                  size_t const first, size_t const last, size_t const num_objectives,
+                                  double const *f, double const max_violation, size_t *const indices)
+{
+    return FindDominatedIndicesBlocked<Avx512>(values, stride, max_violations, first, last, num_objectives, f,
+                                               max_violation, indices);
+}
+#endif
+
+} // namespace mosqp
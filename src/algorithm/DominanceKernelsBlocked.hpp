@@ -0,0 +1,84 @@
+#pragma once
+
+#include "Point.hpp"
+#include <cstddef>
+
+
+// The loops of the vectorised kernels in "DominanceKernelsSimd.hpp", shared by the file of each
+// instruction set. Such a file defines "MOSQP_SIMD_TARGET" for the functions built for it and a
+// struct with the operations on its vectors of "BLOCK_SIZE" doubles:
+//   Vector Load(double const *values)
+//   Vector Broadcast(double value)
+//   Vector Subtract(Vector a, Vector b)
+//   Mask NotLess(Vector a, Vector b)              lanes where "a < b" does not hold, NaNs included
+//   Mask NotLess(Mask mask, Vector a, Vector b)   the same for the lanes set in "mask" only
+//   unsigned int GetBits(Mask mask)               one bit per lane
+// The comparisons are negated "less than", so that NaNs behave as in the scalar version.
+#if !defined(MOSQP_SIMD_TARGET)
+#error "DominanceKernelsBlocked.hpp is only for the files built for one instruction set"
+#endif
+
+
+namespace mosqp
+{
+
+template <typename Simd>
+MOSQP_SIMD_TARGET
+bool AnyDominatesBlocked(double const *values, size_t const stride, double const *max_violations,
+                         size_t const num_points, size_t const num_objectives, double const *f,
+                         double const max_violation)
+{
+    using Vector = typename Simd::Vector;
+    using Mask = typename Simd::Mask;
+    Vector const violation = Simd::Broadcast(max_violation);
+    Vector const tolerance = Simd::Broadcast(Point::TOL_FEAS);
+    for (size_t i = 0; i + Simd::BLOCK_SIZE <= num_points; i += Simd::BLOCK_SIZE)
+    {
+        Vector const other_violation = Simd::Subtract(Simd::Load(max_violations + i), tolerance);
+        Mask mask = Simd::NotLess(violation, other_violation);
+        for (size_t k = 0; k < num_objectives && Simd::GetBits(mask) != 0; k += 1)
+        {
+            Vector const other_f = Simd::Load(values + k * stride + i);
+            mask = Simd::NotLess(mask, Simd::Broadcast(f[k]), other_f);
+        }
+        if (Simd::GetBits(mask) != 0)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+template <typename Simd>
+MOSQP_SIMD_TARGET
+size_t FindDominatedIndicesBlocked(double const *values, size_t const stride, double const *max_violations,
+                                   size_t const first, size_t const last, size_t const num_objectives,
+                                   double const *f, double const max_violation, size_t *const indices)
+{
+    using Vector = typename Simd::Vector;
+    using Mask = typename Simd::Mask;
+    size_t num_dominated = 0;
+    Vector const violation = Simd::Broadcast(max_violation - Point::TOL_FEAS);
+    for (size_t i = first; i < last; i += Simd::BLOCK_SIZE)
+    {
+        Mask mask = Simd::NotLess(Simd::Load(max_violations + i), violation);
+        for (size_t k = 0; k < num_objectives && Simd::GetBits(mask) != 0; k += 1)
+        {
+            Vector const other_f = Simd::Load(values + k * stride + i);
+            mask = Simd::NotLess(mask, other_f, Simd::Broadcast(f[k]));
+        }
+        for (unsigned int bits = Simd::GetBits(mask); bits != 0; bits &= bits - 1)
+        {
+            size_t lane = 0;
+            while (((bits >> lane) & 1) == 0)
+            {
+                lane += 1;
+            }
+            indices[num_dominated] = i + lane;
+            num_dominated += 1;
+        }
+    }
+    return num_dominated;
+}
+
+} // namespace mosqp
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+
+
+// The vectorised kernels are only built for x86.
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define MOSQP_SIMD_KERNELS
+#endif
+
+
+namespace mosqp
+{
+
+#if defined(MOSQP_SIMD_KERNELS)
+// Vectorised versions of the kernels in "DominanceKernels.hpp". Each instruction set has its own
+// file, the only code built for it, so they are only called after checking the CPU at runtime.
+// The files share the loops in "DominanceKernelsBlocked.hpp".
+// They test the points in blocks, "AnyDominates..." leaves the last "num_points % block size"
+// points to the caller.
+//
+// "FindDominatedIndices..." write the indices of the dominated points among "first" to "last" to
+// "indices", which needs room for "last - first" of them, and return how many there are.
+// "last - first" has to be a multiple of the block size. Plain arrays instead of a vector, so
+// that no inline function of the standard library gets built for the instruction set and replaces
+// the one of the rest of the program when linking.
+
+size_t constexpr AVX2_BLOCK_SIZE = 4;
+
+bool AnyDominatesAvx2(double const *values, size_t stride, double const *max_violations, size_t num_points,
+                      size_t num_objectives, double const *f, double max_violation);
+size_t FindDominatedIndicesAvx2(double const *values, size_t stride, double const *max_violations, size_t first,
+                                size_t last, size_t num_objectives, double const *f, double max_violation,
+                                size_t *indices);
+
+size_t constexpr AVX512_BLOCK_SIZE = 8;
+
+bool AnyDominatesAvx512(double const *values, size_t stride, double const *max_violations, size_t num_points,
+                        size_t num_objectives, double const *f, double max_violation);
+size_t FindDominatedIndicesAvx512(double const *values, size_t stride, double const *max_violations, size_t first,
+                                  size_t last, size_t num_objectives, double const *f, double max_violation,
+                                  size_t *indices);
+#endif
+
+} // namespace mosqp
@@ -0,0 +1,239 @@
+#include "Hypervolume.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <map>
+#include <vector>
+
+
+namespace mosqp
+{
+
+// A step of the staircase in "SweepExclusiveHypervolumes". Its exclusive rectangle in the
+// current slice reaches from the point to the next step in x and to the previous step in y.
+struct HypervolumeStep
+{
+    double y;
+    size_t index;
+    // the exclusive area in the slices since the height "since"
+    double area;
+    double since;
+    // The points this one covers in the slice, i.e. the steps it replaced and the points that came
+    // up below it, as a staircase mapping x to y. The region they dominate is not exclusive for this
+    // point, but it only ever shrinks to the part inside the exclusive rectangle. "innerSum" is the
+    // sum of "(x[i + 1] - x[i]) * y[i]" over all but the last of them.
+    std::map<double, double> inner;
+    double innerSum;
+};
+
+using InnerIterator = std::map<double, double>::iterator;
+
+// The term of "innerSum" for a covered step and the one after it.
+static double ComputeInnerTerm(InnerIterator const it, InnerIterator const next)
+{
+    return (next->first - it->first) * it->second;
+}
+
+static void EraseInner(HypervolumeStep &step, InnerIterator const it)
+{
+    std::map<double, double> &inner = step.inner;
+    InnerIterator const next = std::next(it);
+    if (it != inner.begin())
+    {
+        InnerIterator const prev = std::prev(it);
+        step.innerSum -= ComputeInnerTerm(prev, it);
+        if (next != inner.end())
+        {
+            step.innerSum += ComputeInnerTerm(prev, next);
+        }
+    }
+    if (next != inner.end())
+    {
+        step.innerSum -= ComputeInnerTerm(it, next);
+    }
+    inner.erase(it);
+}
+
+// Adds a point the step covers, unless one of the covered steps covers it already. Drops the
+// covered steps the point covers in turn.
+static void AddInner(HypervolumeStep &step, double const x, double const y)
+{
+    std::map<double, double> &inner = step.inner;
+    InnerIterator next = inner.upper_bound(x);
+    if (next != inner.begin() && std::prev(next)->second <= y)
+    {
+        return;
+    }
+
+    next = inner.lower_bound(x);
+    while (next != inner.end() && next->second >= y)
+    {
+        InnerIterator const covered = next;
+        ++next;
+        EraseInner(step, covered);
+    }
+
+    InnerIterator const it = inner.emplace_hint(next, x, y);
+    if (it != inner.begin())
+    {
+        InnerIterator const prev = std::prev(it);
+        if (next != inner.end())
+        {
+            step.innerSum -= ComputeInnerTerm(prev, next);
+        }
+        step.innerSum += ComputeInnerTerm(prev, it);
+    }
+    if (next != inner.end())
+    {
+        step.innerSum += ComputeInnerTerm(it, next);
+    }
+}
+
+// Drops the covered steps that left the exclusive rectangle "[..., next_x) x [..., prev_y)",
+// the rectangle only shrinks so they never come back.
+static void ClipInner(HypervolumeStep &step, double const next_x, double const prev_y)
+{
+    std::map<double, double> &inner = step.inner;
+    while (!inner.empty() && std::prev(inner.end())->first >= next_x)
+    {
+        EraseInner(step, std::prev(inner.end()));
+    }
+    while (!inner.empty() && inner.begin()->second >= prev_y)
+    {
+        EraseInner(step, inner.begin());
+    }
+    if (inner.size() <= 1)
+    {
+        // nothing left to sum up, this also drops what rounding left over
+        step.innerSum = 0;
+    }
+}
+
+// The exclusive area of the step with the given neighbours, "next_x" and "prev_y" are those of
+// the reference point at the ends of the staircase.
+static double ComputeStepArea(HypervolumeStep &step, double const x, double const next_x, double const prev_y)
+{
+    ClipInner(step, next_x, prev_y);
+    double area = (next_x - x) * (prev_y - step.y);
+    if (!step.inner.empty())
+    {
+        auto const first = step.inner.begin();
+        auto const last = std::prev(step.inner.end());
+        area -= prev_y * (next_x - first->first) - step.innerSum - (next_x - last->first) * last->second;
+    }
+    return std::max(0.0, area);
+}
+
+// Computes the exclusive contributions of the points moved up to "lower" in every objective where
+// they are below it, or of the points themselves if "lower" is null.
+static void SweepExclusiveHypervolumes(std::vector<double const *> const &points, double const *const lower,
+                                       double const *const reference, bool const sorted,
+                                       std::vector<double> &contributions)
+{
+    // Sweeps along the third objective. The slice of the dominated region at some height is
+    // dominated by the 2D projections of the points below it, and a point's exclusive part of the
+    // slice changes only when a point is added next to it on the staircase of these projections,
+    // or below it. Every point enters and leaves the staircase and the covered steps once.
+    auto const get_value = [&](size_t const index, size_t const objective_index)
+    {
+        double const value = points[index][objective_index];
+        return (lower != nullptr) ? std::max(value, lower[objective_index]) : value;
+    };
+
+    contributions.assign(points.size(), 0.0);
+    std::vector<size_t> order;
+    if (!sorted)
+    {
+        order.resize(points.size());
+        for (size_t i = 0; i < points.size(); i += 1)
+        {
+            order[i] = i;
+        }
+        std::sort(order.begin(), order.end(),
+                  [&](size_t const a, size_t const b) { return get_value(a, 2) < get_value(b, 2); });
+    }
+
+    // maps the first objective-value of each step to the step, the second objective-values are
+    // strictly descending
+    std::map<double, HypervolumeStep> staircase;
+    // adds up the exclusive volume of the step so far and recomputes its area
+    auto const update = [&](std::map<double, HypervolumeStep>::iterator const it, double const height)
+    {
+        HypervolumeStep &step = it->second;
+        contributions[step.index] += step.area * (height - step.since);
+        step.since = height;
+        auto const next = std::next(it);
+        double const next_x = (next == staircase.end()) ? reference[0] : next->first;
+        double const prev_y = (it == staircase.begin()) ? reference[1] : std::prev(it)->second.y;
+        step.area = ComputeStepArea(step, it->first, next_x, prev_y);
+    };
+
+    for (size_t position = 0; position < points.size(); position += 1)
+    {
+        size_t const index = sorted ? position : order[position];
+        double const x = get_value(index, 0);
+        double const y = get_value(index, 1);
+        double const z = get_value(index, 2);
+        if (!(x < reference[0] && y < reference[1] && z < reference[2]))
+        {
+            continue;
+        }
+
+        auto step = staircase.upper_bound(x);
+        if (step != staircase.begin() && std::prev(step)->second.y <= y)
+        {
+            // weakly dominated by the step before, which then shares the part of its exclusive
+            // rectangle the point dominates
+            auto const dominating = std::prev(step);
+            double const prev_y = (dominating == staircase.begin()) ? reference[1] : std::prev(dominating)->second.y;
+            if (y < prev_y)
+            {
+                AddInner(dominating->second, x, y);
+                update(dominating, z);
+            }
+            continue;
+        }
+
+        HypervolumeStep new_step{ y, index, 0.0, z, {}, 0.0 };
+        step = staircase.lower_bound(x);
+        while (step != staircase.end() && step->second.y >= y)
+        {
+            contributions[step->second.index] += step->second.area * (z - step->second.since);
+            AddInner(new_step, step->first, step->second.y);
+            step = staircase.erase(step);
+        }
+
+        auto const it = staircase.emplace_hint(step, x, std::move(new_step));
+        update(it, z);
+        if (it != staircase.begin())
+        {
+            update(std::prev(it), z);
+        }
+        if (std::next(it) != staircase.end())
+        {
+            update(std::next(it), z);
+        }
+    }
+
+    for (auto it = staircase.begin(); it != staircase.end(); ++it)
+    {
+        contributions[it->second.index] += it->second.area * (reference[2] - it->second.since);
+    }
+}
+
+void ComputeExclusiveHypervolumes3D(std::vector<double const *> const &points, double const *const reference,
+                                    std::vector<double> &contributions, bool const sorted)
+{
+    SweepExclusiveHypervolumes(points, nullptr, reference, sorted, contributions);
+}
+
+void ComputeHypervolumeIncreases3D(double const *const removed, std::vector<double const *> const &points,
+                                   double const *const reference, std::vector<double> &increases,
+                                   bool const sorted)
+{
+    // The region only "removed" and one other point dominate is the exclusive contribution of
+    // that point once all points are cut off at "removed". Moving them up keeps them sorted.
+    SweepExclusiveHypervolumes(points, removed, reference, sorted, increases);
+}
+
+} // namespace mosqp
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <vector>
+
+
+namespace mosqp
+{
+
+// Computes the exclusive hypervolume contribution of each of the "points" with three
+// objective-values, i.e. the volume of the region that is dominated by the point and bounded by
+// "reference", but not dominated by any other of the points. "contributions[i]" belongs to
+// "points[i]". A point weakly dominated by another one contributes nothing, and the region it
+// dominates is not exclusive for the other one either. Takes O(n log n) for all n points, or
+// O(n log s) if they are "sorted" ascending by the third objective-value already, where s is the
+// size of the largest subset whose points don't dominate each other in the first two objectives.
+void ComputeExclusiveHypervolumes3D(std::vector<double const *> const &points, double const *reference,
+                                    std::vector<double> &contributions, bool sorted = false);
+
+// Computes by how much the exclusive contribution of each of the "points" grows once "removed" is
+// not among them anymore, i.e. the volume dominated by "removed" and that point but by no other.
+// This is the above for the points moved up to "removed" where they are below it. Most of them
+// land on the faces of the region "removed" dominates, where few of them are not dominated by
+// each other, so with "sorted" points s stays small and this takes close to O(n).
+void ComputeHypervolumeIncreases3D(double const *removed, std::vector<double const *> const &points,
+                                   double const *reference, std::vector<double> &increases, bool sorted = false);
+
+} // namespace mosqp
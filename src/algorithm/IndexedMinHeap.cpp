@@ -0,0 +1,128 @@
+#include "IndexedMinHeap.hpp"
+#include <cassert>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+
+namespace mosqp
+{
+
+size_t const IndexedMinHeap::NO_POSITION;
+
+void IndexedMinHeap::Push(size_t const id, double const key)
+{
+    if (id >= positions.size())
+    {
+        keys.resize(id + 1);
+        positions.resize(id + 1, NO_POSITION);
+    }
+    assert(positions[id] == NO_POSITION);
+
+    keys[id] = key;
+    positions[id] = heap.size();
+    heap.push_back(id);
+    SiftUp(heap.size() - 1);
+}
+
+void IndexedMinHeap::Update(size_t const id, double const key)
+{
+    assert(Contains(id));
+    bool const decreased = (key < keys[id]);
+    keys[id] = key;
+    if (decreased)
+    {
+        SiftUp(positions[id]);
+    }
+    else
+    {
+        SiftDown(positions[id]);
+    }
+}
+
+void IndexedMinHeap::Pop()
+{
+    assert(!IsEmpty());
+    Swap(0, heap.size() - 1);
+    positions[heap.back()] = NO_POSITION;
+    heap.pop_back();
+    if (!heap.empty())
+    {
+        SiftDown(0);
+    }
+}
+
+void IndexedMinHeap::Clear()
+{
+    heap.clear();
+    keys.clear();
+    positions.clear();
+}
+
+size_t IndexedMinHeap::Top() const
+{
+    return heap.front();
+}
+
+bool IndexedMinHeap::Contains(size_t const id) const
+{
+    return id < positions.size() && positions[id] != NO_POSITION;
+}
+
+bool IndexedMinHeap::IsEmpty() const
+{
+    return heap.empty();
+}
+
+bool IndexedMinHeap::IsLess(size_t const id, size_t const other_id) const
+{
+    return keys[id] < keys[other_id] || (keys[id] == keys[other_id] && id < other_id);
+}
+
+void IndexedMinHeap::SiftUp(size_t position)
+{
+    while (position > 0)
+    {
+        size_t const parent = (position - 1) / 2;
+        if (!IsLess(heap[position], heap[parent]))
+        {
+            break;
+        }
+        Swap(position, parent);
+        position = parent;
+    }
+}
+
+void IndexedMinHeap::SiftDown(size_t position)
+{
+    size_t const size = heap.size();
+    while (true)
+    {
+        size_t smallest = position;
+        size_t const left = 2 * position + 1;
+        size_t const right = left + 1;
+        if (left < size && IsLess(heap[left], heap[smallest]))
+        {
+            smallest = left;
+        }
+        if (right < size && IsLess(heap[right], heap[smallest]))
+        {
+            smallest = right;
+        }
+        if (smallest == position)
+        {
+            break;
+        }
+        Swap(position, smallest);
+        position = smallest;
+    }
+}
+
+void IndexedMinHeap::Swap(size_t const position, size_t const other_position)
+{
+    std::swap(heap[position], heap[other_position]);
+    positions[heap[position]] = position;
+    positions[heap[other_position]] = other_position;
+}
+
+} // namespace mosqp
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+
+namespace mosqp
+{
+
+// Binary min-heap of ids with a key each, that also knows where every id is in the heap.
+// This allows changing the key of any id in O(log n). Ties are broken by the smaller id.
+class IndexedMinHeap
+{
+public:
+    void Push(size_t id, double key);
+    // The id has to be in the heap.
+    void Update(size_t id, double key);
+    // Removes the id with the smallest key.
+    void Pop();
+    void Clear();
+
+    size_t Top() const;
+    bool Contains(size_t id) const;
+    bool IsEmpty() const;
+
+private:
+    static size_t const NO_POSITION = static_cast<size_t>(-1);
+
+    // The ids in heap order.
+    std::vector<size_t> heap;
+    // Key and position in "heap" of each id.
+    std::vector<double> keys;
+    std::vector<size_t> positions;
+
+    bool IsLess(size_t id, size_t other_id) const;
+    void SiftUp(size_t position);
+    void SiftDown(size_t position);
+    void Swap(size_t position, size_t other_position);
+};
+
+} // namespace mosqp
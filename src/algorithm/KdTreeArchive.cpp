@@ -0,0 +1,364 @@
+#include "KdTreeArchive.hpp"
+#include "ArrayView.hpp"
+#include "DominanceArchive.hpp"
+#include "Point.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <vector>
+
+
+namespace mosqp
+{
+
+bool KdTreeArchive::Node::IsLeaf() const
+{
+    return left == NO_NODE;
+}
+
+KdTreeArchive::KdTreeArchive(size_t const num_objectives)
+    : numObjectives(num_objectives), numRemoved(0)
+{
+    NewNode(NO_NODE);
+}
+
+std::unique_ptr<DominanceArchive> KdTreeArchive::Clone() const
+{
+    return std::make_unique<KdTreeArchive>(*this);
+}
+
+void KdTreeArchive::Insert(size_t const slot, Point const &point)
+{
+    ArrayView const f = point.GetObjectiveValues();
+    double const max_violation = point.GetMaxViolation();
+    if (slot >= slotLeaves.size())
+    {
+        values.resize((slot + 1) * numObjectives);
+        maxViolations.resize(slot + 1);
+        slotLeaves.resize(slot + 1);
+        slotPositions.resize(slot + 1);
+    }
+    std::copy(f.cbegin(), f.cend(), values.begin() + slot * numObjectives);
+    maxViolations[slot] = max_violation;
+
+    // descend to the leaf and remember the topmost node that gets too unbalanced
+    size_t node_index = 0;
+    size_t scapegoat = NO_NODE;
+    while (!nodes[node_index].IsLeaf())
+    {
+        Node &node = nodes[node_index];
+        ExtendBounds(node, f.data(), max_violation);
+        node.size += 1;
+        size_t const child = (f[node.splitObjective] < node.splitValue) ? node.left : node.right;
+        if (scapegoat == NO_NODE && node.size >= 4 * LEAF_SIZE && 4 * (nodes[child].size + 1) > 3 * node.size)
+        {
+            scapegoat = node_index;
+        }
+        node_index = child;
+    }
+
+    Node &leaf = nodes[node_index];
+    ExtendBounds(leaf, f.data(), max_violation);
+    leaf.size += 1;
+    slotLeaves[slot] = node_index;
+    slotPositions[slot] = leaf.slots.size();
+    leaf.slots.push_back(slot);
+
+    if (scapegoat != NO_NODE)
+    {
+        Rebuild(scapegoat);
+    }
+    else if (leaf.slots.size() > LEAF_SIZE)
+    {
+        Rebuild(node_index);
+    }
+}
+
+void KdTreeArchive::Remove(size_t const slot, Point const &point)
+{
+    size_t node_index = slotLeaves[slot];
+    std::vector<size_t> &leaf_slots = nodes[node_index].slots;
+    size_t const position = slotPositions[slot];
+    assert(leaf_slots[position] == slot);
+
+    leaf_slots[position] = leaf_slots.back();
+    slotPositions[leaf_slots[position]] = position;
+    leaf_slots.pop_back();
+    while (node_index != NO_NODE)
+    {
+        nodes[node_index].size -= 1;
+        node_index = nodes[node_index].parent;
+    }
+
+    // the boxes don't shrink on removal, so tighten them once in a while
+    numRemoved += 1;
+    if (numRemoved > NumPoints())
+    {
+        Rebuild(0);
+        numRemoved = 0;
+    }
+}
+
+void KdTreeArchive::Clear()
+{
+    nodes.clear();
+    freeNodes.clear();
+    values.clear();
+    maxViolations.clear();
+    slotLeaves.clear();
+    slotPositions.clear();
+    numRemoved = 0;
+    NewNode(NO_NODE);
+}
+
+bool KdTreeArchive::IsDominated(Point const &point) const
+{
+    return IsDominated(0, point.GetObjectiveValues().data(), point.GetMaxViolation());
+}
+
+void KdTreeArchive::FindDominated(Point const &point, std::vector<size_t> &slots) const
+{
+    FindDominated(0, point.GetObjectiveValues().data(), point.GetMaxViolation(), slots);
+}
+
+size_t KdTreeArchive::NumPoints() const
+{
+    return nodes[0].size;
+}
+
+double const * KdTreeArchive::GetValues(size_t const slot) const
+{
+    return &values[slot * numObjectives];
+}
+
+size_t KdTreeArchive::NewNode(size_t const parent)
+{
+    size_t node_index;
+    if (freeNodes.empty())
+    {
+        node_index = nodes.size();
+        nodes.emplace_back();
+    }
+    else
+    {
+        node_index = freeNodes.back();
+        freeNodes.pop_back();
+    }
+
+    ResetNode(node_index, parent);
+    return node_index;
+}
+
+void KdTreeArchive::ResetNode(size_t const node_index, size_t const parent)
+{
+    Node &node = nodes[node_index];
+    node.lower.assign(numObjectives, std::numeric_limits<double>::infinity());
+    node.upper.assign(numObjectives, -std::numeric_limits<double>::infinity());
+    node.minViolation = std::numeric_limits<double>::infinity();
+    node.maxViolation = -std::numeric_limits<double>::infinity();
+    node.size = 0;
+    node.parent = parent;
+    node.left = NO_NODE;
+    node.right = NO_NODE;
+    node.slots.clear();
+}
+
+void KdTreeArchive::Build(size_t const node_index, std::vector<size_t> &slots,
+                          size_t const begin, size_t const end)
+{
+    ResetNode(node_index, nodes[node_index].parent);
+    Node &node = nodes[node_index];
+    for (size_t i = begin; i < end; i += 1)
+    {
+        ExtendBounds(node, GetValues(slots[i]), maxViolations[slots[i]]);
+    }
+    node.size = end - begin;
+
+    // split along the objective with the largest spread, unless all points are equal
+    size_t split_objective = 0;
+    double max_spread = 0;
+    for (size_t i = 0; i < numObjectives; i += 1)
+    {
+        if (node.upper[i] - node.lower[i] > max_spread)
+        {
+            max_spread = node.upper[i] - node.lower[i];
+            split_objective = i;
+        }
+    }
+
+    if (node.size <= LEAF_SIZE || max_spread == 0)
+    {
+        for (size_t i = begin; i < end; i += 1)
+        {
+            slotLeaves[slots[i]] = node_index;
+            slotPositions[slots[i]] = i - begin;
+        }
+        node.slots.assign(slots.begin() + begin, slots.begin() + end);
+        return;
+    }
+
+    auto const value_of = [&](size_t const slot) { return values[slot * numObjectives + split_objective]; };
+    auto const is_smaller = [&](size_t const a, size_t const b) { return value_of(a) < value_of(b); };
+    size_t const median = begin + (end - begin) / 2;
+    std::nth_element(slots.begin() + begin, slots.begin() + median, slots.begin() + end, is_smaller);
+    double split_value = value_of(slots[median]);
+    if (split_value == node.lower[split_objective])
+    {
+        // the median is the minimum, so split right above it to keep both halves non-empty
+        split_value = node.upper[split_objective];
+        for (size_t i = begin; i < end; i += 1)
+        {
+            if (value_of(slots[i]) > node.lower[split_objective])
+            {
+                split_value = std::min(split_value, value_of(slots[i]));
+            }
+        }
+    }
+    node.splitObjective = split_objective;
+    node.splitValue = split_value;
+
+    auto const middle = std::partition(slots.begin() + begin, slots.begin() + end,
+                                       [&](size_t const slot) { return value_of(slot) < split_value; });
+    size_t const split = middle - slots.begin();
+    size_t const left = NewNode(node_index);
+    size_t const right = NewNode(node_index);
+    // creating the children may have moved the nodes
+    nodes[node_index].left = left;
+    nodes[node_index].right = right;
+    Build(left, slots, begin, split);
+    Build(right, slots, split, end);
+}
+
+void KdTreeArchive::Rebuild(size_t const node_index)
+{
+    std::vector<size_t> slots;
+    slots.reserve(nodes[node_index].size);
+    CollectSlots(node_index, slots, false);
+    Build(node_index, slots, 0, slots.size());
+}
+
+void KdTreeArchive::CollectSlots(size_t const node_index, std::vector<size_t> &slots, bool const free_node)
+{
+    Node const &node = nodes[node_index];
+    if (free_node)
+    {
+        freeNodes.push_back(node_index);
+    }
+
+    if (node.IsLeaf())
+    {
+        slots.insert(slots.end(), node.slots.cbegin(), node.slots.cend());
+    }
+    else
+    {
+        CollectSlots(node.left, slots, true);
+        CollectSlots(node.right, slots, true);
+    }
+}
+
+void KdTreeArchive::ExtendBounds(Node &node, double const *const f, double const max_violation)
+{
+    for (size_t i = 0; i < numObjectives; i += 1)
+    {
+        node.lower[i] = std::min(node.lower[i], f[i]);
+        node.upper[i] = std::max(node.upper[i], f[i]);
+    }
+    node.minViolation = std::min(node.minViolation, max_violation);
+    node.maxViolation = std::max(node.maxViolation, max_violation);
+}
+
+bool KdTreeArchive::IsDominated(size_t const node_index, double const *const f, double const max_violation) const
+{
+    Node const &node = nodes[node_index];
+    if (node.size == 0 || max_violation < node.minViolation - Point::TOL_FEAS)
+    {
+        return false;
+    }
+
+    bool box_dominates = (max_violation >= node.maxViolation - Point::TOL_FEAS);
+    for (size_t i = 0; i < numObjectives; i += 1)
+    {
+        if (node.lower[i] > f[i])
+        {
+            return false;
+        }
+        box_dominates = box_dominates && (node.upper[i] <= f[i]);
+    }
+
+    if (box_dominates)
+    {
+        return true;
+    }
+
+    if (node.IsLeaf())
+    {
+        for (size_t slot : node.slots)
+        {
+            if (Point::IsDominated(f, max_violation, GetValues(slot), maxViolations[slot], numObjectives))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    return IsDominated(node.left, f, max_violation) || IsDominated(node.right, f, max_violation);
+}
+
+void KdTreeArchive::FindDominated(size_t const node_index, double const *const f, double const max_violation,
+                                  std::vector<size_t> &slots) const
+{
+    Node const &node = nodes[node_index];
+    if (node.size == 0 || node.maxViolation < max_violation - Point::TOL_FEAS)
+    {
+        return;
+    }
+
+    bool box_dominated = (node.minViolation >= max_violation - Point::TOL_FEAS);
+    for (size_t i = 0; i < numObjectives; i += 1)
+    {
+        if (node.upper[i] < f[i])
+        {
+            return;
+        }
+        box_dominated = box_dominated && (node.lower[i] >= f[i]);
+    }
+
+    if (box_dominated)
+    {
+        AppendSlots(node_index, slots);
+    }
+    else if (node.IsLeaf())
+    {
+        for (size_t slot : node.slots)
+        {
+            if (Point::IsDominated(GetValues(slot), maxViolations[slot], f, max_violation, numObjectives))
+            {
+                slots.push_back(slot);
+            }
+        }
+    }
+    else
+    {
+        FindDominated(node.left, f, max_violation, slots);
+        FindDominated(node.right, f, max_violation, slots);
+    }
+}
+
+void KdTreeArchive::AppendSlots(size_t const node_index, std::vector<size_t> &slots) const
+{
+    Node const &node = nodes[node_index];
+    if (node.IsLeaf())
+    {
+        slots.insert(slots.end(), node.slots.cbegin(), node.slots.cend());
+    }
+    else
+    {
+        AppendSlots(node.left, slots);
+        AppendSlots(node.right, slots);
+    }
+}
+
+} // namespace mosqp
@@ -0,0 +1,97 @@
+#pragma once
+
+#include "DominanceArchive.hpp"
+#include "Point.hpp"
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+
+namespace mosqp
+{
+
+// Archive for any number of objectives that keeps the points in a k-d tree over their
+// objective-values. Every node knows a box containing the objective-values and the range of
+// the violations of all points below it, so a query can skip every subtree whose box cannot
+// hold a dominating (or dominated) point, and can accept a whole subtree whose box lies
+// entirely in the dominating (or dominated) region.
+// Leaves hold up to "LEAF_SIZE" points and are split at the median of the objective with the
+// largest spread. Subtrees that become unbalanced by insertions are rebuilt from scratch, as in
+// a scapegoat tree, and the whole tree is rebuilt once as many points were removed as are left.
+class KdTreeArchive : public DominanceArchive
+{
+public:
+    KdTreeArchive(size_t num_objectives);
+
+    std::unique_ptr<DominanceArchive> Clone() const override;
+
+    void Insert(size_t slot, Point const &point) override;
+    void Remove(size_t slot, Point const &point) override;
+    void Clear() override;
+
+    bool IsDominated(Point const &point) const override;
+    void FindDominated(Point const &point, std::vector<size_t> &slots) const override;
+
+    size_t NumPoints() const;
+
+private:
+    static size_t const LEAF_SIZE = 16;
+    static size_t const NO_NODE = static_cast<size_t>(-1);
+
+    struct Node
+    {
+        // Box around the objective-values of the points below this node. Removing a point
+        // does not shrink the box, so it is only guaranteed to contain the points.
+        std::vector<double> lower;
+        std::vector<double> upper;
+        double minViolation;
+        double maxViolation;
+        // Number of points below this node.
+        size_t size;
+        size_t parent;
+        // Inner nodes only. Points with an objective-value below "splitValue" in the
+        // objective "splitObjective" are in the left subtree, all others in the right one.
+        size_t left;
+        size_t right;
+        size_t splitObjective;
+        double splitValue;
+        // Leaves only.
+        std::vector<size_t> slots;
+
+        bool IsLeaf() const;
+    };
+
+    size_t const numObjectives;
+    // All nodes of the tree, the root is the first one. Nodes of rebuilt subtrees are
+    // kept in "freeNodes" for reuse.
+    std::vector<Node> nodes;
+    std::vector<size_t> freeNodes;
+    // Objective-values of the stored points, "numObjectives" consecutive entries per slot.
+    std::vector<double> values;
+    std::vector<double> maxViolations;
+    // Leaf of each slot and its position in the slots of that leaf.
+    std::vector<size_t> slotLeaves;
+    std::vector<size_t> slotPositions;
+    // Points removed since the last rebuild of the whole tree.
+    size_t numRemoved;
+
+    double const * GetValues(size_t slot) const;
+    size_t NewNode(size_t parent);
+    // Turns the node into an empty leaf with empty bounds.
+    void ResetNode(size_t node_index, size_t parent);
+    // Turns the given node into a balanced subtree holding exactly the given slots.
+    void Build(size_t node_index, std::vector<size_t> &slots, size_t begin, size_t end);
+    // Collects the slots below the given node and builds the subtree anew.
+    void Rebuild(size_t node_index);
+    void CollectSlots(size_t node_index, std::vector<size_t> &slots, bool free_node);
+    // Adds the given point to the box and the violation range of the node.
+    void ExtendBounds(Node &node, double const *f, double max_violation);
+
+    bool IsDominated(size_t node_index, double const *f, double max_violation) const;
+    void FindDominated(size_t node_index, double const *f, double max_violation,
+                       std::vector<size_t> &slots) const;
+    // Appends all slots below the given node.
+    void AppendSlots(size_t node_index, std::vector<size_t> &slots) const;
+};
+
+} // namespace mosqp
@@ -0,0 +1,113 @@
+#include "LinearArchive.hpp"
+#include "ArrayView.hpp"
+#include "DominanceArchive.hpp"
+#include "DominanceKernels.hpp"
+#include "Point.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+
+namespace mosqp
+{
+
+LinearArchive::LinearArchive(size_t const num_objectives)
+    : numObjectives(num_objectives), stride(0)
+{
+}
+
+std::unique_ptr<DominanceArchive> LinearArchive::Clone() const
+{
+    return std::make_unique<LinearArchive>(*this);
+}
+
+void LinearArchive::Insert(size_t const slot, Point const &point)
+{
+    ArrayView const f = point.GetObjectiveValues();
+    if (slot >= slotPositions.size())
+    {
+        slotPositions.resize(slot + 1);
+    }
+    size_t const index = slots.size();
+    if (index == stride)
+    {
+        Reserve(2 * index);
+    }
+
+    slotPositions[slot] = index;
+    slots.push_back(slot);
+    for (size_t k = 0; k < numObjectives; k += 1)
+    {
+        values[k * stride + index] = f[k];
+    }
+    values[numObjectives * stride + index] = point.GetMaxViolation();
+}
+
+void LinearArchive::Remove(size_t const slot, Point const &point)
+{
+    size_t const index = slotPositions[slot];
+    size_t const last_index = slots.size() - 1;
+    assert(slots[index] == slot);
+
+    if (index != last_index)
+    {
+        for (size_t k = 0; k <= numObjectives; k += 1)
+        {
+            values[k * stride + index] = values[k * stride + last_index];
+        }
+        slots[index] = slots[last_index];
+        slotPositions[slots[index]] = index;
+    }
+
+    slots.pop_back();
+}
+
+void LinearArchive::Clear()
+{
+    // keeps the buffer for the next points
+    slots.clear();
+    slotPositions.clear();
+}
+
+bool LinearArchive::IsDominated(Point const &point) const
+{
+    return AnyDominates(values.data(), stride, GetMaxViolations(), slots.size(), numObjectives,
+                        point.GetObjectiveValues().data(), point.GetMaxViolation());
+}
+
+void LinearArchive::FindDominated(Point const &point, std::vector<size_t> &dominated_slots) const
+{
+    size_t const first = dominated_slots.size();
+    FindDominatedIndices(values.data(), stride, GetMaxViolations(), slots.size(), numObjectives,
+                         point.GetObjectiveValues().data(), point.GetMaxViolation(), dominated_slots);
+    for (size_t i = first; i < dominated_slots.size(); i += 1)
+    {
+        dominated_slots[i] = slots[dominated_slots[i]];
+    }
+}
+
+size_t LinearArchive::NumPoints() const
+{
+    return slots.size();
+}
+
+void LinearArchive::Reserve(size_t const num_points)
+{
+    size_t const new_stride = std::max((num_points + ROW_PADDING - 1) / ROW_PADDING, size_t(1)) * ROW_PADDING;
+    std::vector<double, AlignedAllocator<double, ALIGNMENT>> new_values((numObjectives + 1) * new_stride);
+    for (size_t k = 0; k <= numObjectives; k += 1)
+    {
+        std::copy_n(values.cbegin() + k * stride, slots.size(), new_values.begin() + k * new_stride);
+    }
+    values.swap(new_values);
+    stride = new_stride;
+}
+
+double const * LinearArchive::GetMaxViolations() const
+{
+    return values.data() + numObjectives * stride;
+}
+
+} // namespace mosqp
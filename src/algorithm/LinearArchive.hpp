@@ -0,0 +1,54 @@
+#pragma once
+
+#include "AlignedAllocator.hpp"
+#include "DominanceArchive.hpp"
+#include "Point.hpp"
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+
+namespace mosqp
+{
+
+// Archive that compares a point against every stored point, i.e. O(n) per query.
+// Works for any number of objectives. The values of each objective are stored contiguously, so
+// that the comparisons can be vectorized (see "DominanceKernels.hpp").
+class LinearArchive : public DominanceArchive
+{
+public:
+    LinearArchive(size_t num_objectives);
+
+    std::unique_ptr<DominanceArchive> Clone() const override;
+
+    void Insert(size_t slot, Point const &point) override;
+    void Remove(size_t slot, Point const &point) override;
+    void Clear() override;
+
+    bool IsDominated(Point const &point) const override;
+    void FindDominated(Point const &point, std::vector<size_t> &slots) const override;
+
+    size_t NumPoints() const;
+
+private:
+    // The rows of "values" start at multiples of this many bytes, a cache line, and their length
+    // is a multiple of the block size of all kernels.
+    static size_t const ALIGNMENT = 64;
+    static size_t const ROW_PADDING = ALIGNMENT / sizeof(double);
+
+    size_t const numObjectives;
+    // Room for this many points in each row of "values".
+    size_t stride;
+    // One buffer for the objective-values of the stored points, one row of "stride" values per
+    // objective, followed by a row with their violations.
+    std::vector<double, AlignedAllocator<double, ALIGNMENT>> values;
+    std::vector<size_t> slots;
+    // Position of each slot in the rows above. Removing a point moves the last one into its place.
+    std::vector<size_t> slotPositions;
+
+    // Moves the rows to a buffer with room for at least "num_points" points.
+    void Reserve(size_t num_points);
+    double const * GetMaxViolations() const;
+};
+
+} // namespace mosqp
@@ -1,16 +1,29 @@
 #include "MOSQP.hpp"
+#include "ArrayView.hpp"
 #include "ParetoFront.hpp"
 #include "Point.hpp"
+#include "ThreadPool.hpp"
 #include "worhp/worhp.h"
+#include "../nlp_solver/SolverPool.hpp"
 #include "../nlp_solver/WorhpSolver.hpp"
 #include "../problem_formulation/MONLP.hpp"
 #include "../problem_formulation/CombinedMONLP.hpp"
 #include "../problem_formulation/SingleMONLP.hpp"
 #include <algorithm>
 #include <cassert>
+#include <chrono>
+#include <condition_variable>
 #include <cstddef>
+#include <deque>
 #include <iostream>
+#include <iterator>
 #include <memory>
+#include <mutex>
+#include <numeric>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
 
 
 namespace mosqp
@@ -19,9 +32,13 @@ namespace mosqp
 // set default parameters
 Parameters::Parameters()
     : maxPoints(100),
+      archiveType(ArchiveType::Automatic),
+      truncationType(TruncationType::CrowdingDistance),
+      hypervolumeReferenceOffset(0.1),
       numCompletionTries(200),
       TOL_FEAS(1e-3),
       TOL_DOMINATION(1e-5),
+      KEEP_VIOLATIONS(true),
       SPREAD_MAX_STEPS(20),
       SPREAD_ARMIJO_MIN_ALPHA(1e-5),
       SPREAD_ARMIJO_BETA(0.5),
@@ -29,18 +46,28 @@ Parameters::Parameters()
       REFINE_MAX_STEPS(200),
       REFINE_ARMIJO_MIN_ALPHA(1e-5),
       REFINE_ARMIJO_BETA(0.5),
-      REFINE_MIN_SEARCH_LENGTH(5e-5)
+      REFINE_MIN_SEARCH_LENGTH(5e-5),
+      numThreads(1),
+      pipelineStages(false)
 {
 }
 
-MOSQP::MOSQP(MONLP &monlp, std::vector<Point> initial_points, Parameters parameters)
-    : monlp(monlp), initialPoints(initial_points), parameters(parameters),
-      paretoFront(parameters.maxPoints, monlp.GetNumObjectives(), initial_points),
-      log("log.txt")
+// Sets the tolerances of "Point" in the member initialisers, before "paretoFront" is built from
+// the initial points, as its archive already sorts them by feasibility.
+static Parameters const & ApplyPointTolerances(Parameters const &parameters)
 {
     Point::TOL_FEAS = parameters.TOL_FEAS;
     Point::TOL_DOMINATION = parameters.TOL_DOMINATION;
+    Point::KEEP_VIOLATIONS = parameters.KEEP_VIOLATIONS;
+    return parameters;
+}
 
+MOSQP::MOSQP(MONLP &monlp, std::vector<Point> initial_points, Parameters parameters)
+    : monlp(monlp), initialPoints(initial_points), parameters(ApplyPointTolerances(parameters)),
+      paretoFront(parameters.maxPoints, monlp.GetNumObjectives(), initial_points,
+                  parameters.archiveType, parameters.truncationType, parameters.hypervolumeReferenceOffset),
+      log("log.txt"), threadPool(std::max(parameters.numThreads, 0))
+{
     log << "Stage 0: Initialisation - " << monlp.GetName() << std::endl;
     CompleteInitialPoints();
     std::cout << "================= Complete Initial Points =================" << std::endl;
@@ -54,18 +81,28 @@ MOSQP::~MOSQP()
 
 ParetoFront MOSQP::Solve()
 {
-    log << "Stage 1: Spread - " << monlp.GetName() << std::endl;
-    std::cout << "==================== SpreadParetoFront ====================" << std::endl;
-    SpreadParetoFront();
-
-    /*log << "Stage 1.5: Extreme Points - " << monlp.GetName() << std::endl;
-    std::cout << "================= AddExtremeParetoPoints ==================" << std::endl;
-    AddExtremeParetoPoints();*/
-    scalings = { 1.0, 1.0 };
-
-    log << "Stage 2: Refine - " << monlp.GetName() << std::endl;
-    std::cout << "==================== RefineParetoFront ====================" << std::endl;
-    RefineParetoFront();
+    if (parameters.pipelineStages)
+    {
+        scalings = std::vector<double>(monlp.GetNumObjectives(), 1.0);
+        log << "Stage 1+2: Spread and Refine - " << monlp.GetName() << std::endl;
+        std::cout << "================= SpreadAndRefinePipelined ================" << std::endl;
+        SpreadAndRefinePipelined();
+    }
+    else
+    {
+        log << "Stage 1: Spread - " << monlp.GetName() << std::endl;
+        std::cout << "==================== SpreadParetoFront ====================" << std::endl;
+        SpreadParetoFront();
+
+        /*log << "Stage 1.5: Extreme Points - " << monlp.GetName() << std::endl;
+        std::cout << "================= AddExtremeParetoPoints ==================" << std::endl;
+        AddExtremeParetoPoints();*/
+        scalings = std::vector<double>(monlp.GetNumObjectives(), 1.0);
+
+        log << "Stage 2: Refine - " << monlp.GetName() << std::endl;
+        std::cout << "==================== RefineParetoFront ====================" << std::endl;
+        RefineParetoFront();
+    }
 
     assert(paretoFront.AllFeasible());
     assert(paretoFront.AllNonDominated());
@@ -97,75 +134,54 @@ void MOSQP::SpreadParetoFront()
     paretoFront.UnstopAll();
 
     size_t const num_objectives = monlp.GetNumObjectives();
-    // 1 solver for each objective
-    std::vector<WorhpSolver> worhp;
-    worhp.reserve(num_objectives);
+    size_t const num_threads = threadPool.GetNumThreads();
+    // 1 solver for each objective and thread, the solvers of thread "t" start at "t * num_objectives"
+    std::vector<std::unique_ptr<WorhpSolver>> worhp;
+    worhp.reserve(num_threads * num_objectives);
     // the solvers store a reference to the problem so we gotta make sure they
     // actually survive throughout so make a vector of em (idk man, this feels so bad,
     // maybe using unique_ptr or something would be better here)
     std::vector<SingleMONLP> problems;
-    problems.reserve(num_objectives);
-    for (size_t objective_index = 0; objective_index < num_objectives; objective_index += 1)
+    problems.reserve(num_threads * num_objectives);
+    for (size_t thread_index = 0; thread_index < num_threads; thread_index += 1)
     {
-        problems.emplace_back(monlp, objective_index);
-        worhp.emplace_back(problems.back());
-        worhp[objective_index].par.ArmijoMinAlpha = parameters.SPREAD_ARMIJO_MIN_ALPHA;
-        worhp[objective_index].par.ArmijoBeta = parameters.SPREAD_ARMIJO_BETA;
-        worhp[objective_index].par.ArmijoBetaAres = parameters.SPREAD_ARMIJO_BETA;
-        worhp[objective_index].par.KeepAcceptableSol = false;
-        worhp[objective_index].par.LowPassFilter = false;
-        worhp[objective_index].par.MaxIter = std::numeric_limits<int>::max();
-        worhp[objective_index].par.LineSearchMethod = 1;  // use merit function instead of filter
-        worhp[objective_index].par.TolFeas = 1e-20;
-        worhp[objective_index].par.TolOpti = 1e-20;
+        for (size_t objective_index = 0; objective_index < num_objectives; objective_index += 1)
+        {
+            problems.emplace_back(monlp, objective_index);
+            worhp.push_back(solverPool.Acquire(problems.back()));
+        }
     }
 
     std::vector<Point> new_points;
-    std::vector<double> x;
-    std::vector<double> lambda;
-    std::vector<double> mu;
-    std::vector<double> penalties;
-    double step_length;
+    std::vector<SolveResult> results;
+    threadPool.ResetStatistics();
 
     for (int step = 0; step < parameters.SPREAD_MAX_STEPS; step += 1)
     {
+        std::vector<size_t> const unstopped = GetUnstoppedPoints();
+        results.clear();
+        // one task per point and objective, so that even a few points keep all threads busy
+        results.resize(unstopped.size() * num_objectives);
+        threadPool.ParallelFor(results.size(), [&](size_t const task_index, size_t const thread_index)
+        {
+            Point const &point = paretoFront.begin()[unstopped[task_index / num_objectives]];
+            size_t const i = task_index % num_objectives;
+            SpreadFromPoint(point, problems[thread_index * num_objectives + i],
+                            *worhp[thread_index * num_objectives + i], results[task_index]);
+        });
+
+        // merge in the order of the serial loop, so that the front does not depend on the threads
         new_points.clear();
+        for (SolveResult &result : results)
+        {
+            std::cout << result.output;
+            std::move(result.newPoints.begin(), result.newPoints.end(), std::back_inserter(new_points));
+        }
+
         for (auto it_point = paretoFront.begin(); it_point != paretoFront.end(); )
         {
             if (!it_point->IsStopped())
             {
-                for (size_t i = 0; i < num_objectives; i += 1)
-                {
-                    worhp[i].SetInitialGuess(*it_point);
-                    worhp[i].DoMajorIter();
-
-                    if (worhp[i].cnt.status <= TerminateError)
-                    {
-                        // couldn't find step in any way so not gonna add this
-                        std::cout << "SpreadParetoFront: WORHP terminated with status '"
-                                  << worhp[i].cnt.status << "'!" << std::endl;
-                    }
-                    else
-                    {
-                        step_length = it_point->GetDistance(worhp[i].opt.X);
-                        if (step_length < parameters.SPREAD_MIN_SEARCH_LENGTH)
-                        {
-                            // search length too small, TODO: go into feasibility restoration
-                            std::cout << "SpreadParetoFront: Search length too small!" << std::endl;
-                        }
-                        else
-                        {
-                            // everything fine
-                            x.assign(worhp[i].opt.X, worhp[i].opt.X + monlp.GetNumVariables());
-                            lambda.assign(worhp[i].opt.Lambda, worhp[i].opt.Lambda + monlp.GetNumVariables());
-                            mu.assign(worhp[i].opt.Mu, worhp[i].opt.Mu + monlp.GetNumConstraints());
-                            double *penalty = worhp[i].wsp.penalty;
-                            penalties.assign(penalty, penalty + monlp.GetNumConstraints());
-                            new_points.emplace_back(x, lambda, mu, penalties, worhp[i].wsp.MeritNewValue, monlp);
-                        }
-                    }
-                }
-
                 it_point->SetStopped(true);
                 // they do this for some reason, but why remove points just because they are
                 // infeasible when they will be thrown out by cleanup method anyways. These
@@ -180,7 +196,7 @@ void MOSQP::SpreadParetoFront()
             it_point += 1;
         }
 
-        int num_added = paretoFront.AddPoints(new_points);
+        int num_added = paretoFront.AddPoints(std::move(new_points));
         std::cout << "SpreadParetoFront: Added " << num_added << " points" << std::endl;
         paretoFront.WriteF(log);
         if (paretoFront.AllStopped())
@@ -189,6 +205,13 @@ void MOSQP::SpreadParetoFront()
             break;
         }
     }
+
+    WriteUtilisation("SpreadParetoFront");
+
+    for (size_t i = 0; i < worhp.size(); i += 1)
+    {
+        solverPool.Release(problems[i], std::move(worhp[i]));
+    }
 }
 
 void MOSQP::AddExtremeParetoPoints()
@@ -221,22 +244,32 @@ void MOSQP::AddExtremeParetoPoints()
         }
     }
 
-    // find extreme points
-    std::vector<double> new_coordinates;
+    // find extreme points, each objective is solved as one task
     size_t const num_objectives = monlp.GetNumObjectives();
-    for (size_t objective_index = 0; objective_index < num_objectives; objective_index += 1)
+    std::vector<SolveResult> results(num_objectives);
+    threadPool.ResetStatistics();
+    threadPool.ParallelFor(num_objectives, [&](size_t const objective_index, size_t)
     {
         SingleMONLP problem(monlp, objective_index);
-        std::unique_ptr<WorhpSolver> worhp(std::make_unique<WorhpSolver>(problem));
+        std::unique_ptr<WorhpSolver> worhp = solverPool.Acquire(problem);
         worhp->SetInitialGuess(x0);
         worhp->Solve();
 
         if (worhp->cnt.status >= TerminateSuccess)
         {
-            new_coordinates.assign(worhp->opt.X, worhp->opt.X + monlp.GetNumVariables());
-            Point extreme_point(new_coordinates, monlp);
-            scalings.push_back(1.0 + std::abs(extreme_point.GetObjectiveValue(objective_index)));
-            paretoFront.AddPoint(extreme_point);
+            results[objective_index].newPoints.emplace_back(ArrayView(worhp->opt.X, monlp.GetNumVariables()), monlp);
+        }
+        solverPool.Release(problem, std::move(worhp));
+    });
+    WriteUtilisation("AddExtremeParetoPoints");
+
+    for (size_t objective_index = 0; objective_index < num_objectives; objective_index += 1)
+    {
+        std::vector<Point> &extreme_points = results[objective_index].newPoints;
+        if (!extreme_points.empty())
+        {
+            scalings.push_back(1.0 + std::abs(extreme_points.front().GetObjectiveValue(objective_index)));
+            paretoFront.AddPoint(std::move(extreme_points.front()));
         }
         else
         {
@@ -251,74 +284,45 @@ void MOSQP::RefineParetoFront()
 {
     paretoFront.UnstopAll();
 
-    CombinedMONLP combinedProblem(monlp, scalings);
-    std::unique_ptr<WorhpSolver> worhp(std::make_unique<WorhpSolver>(combinedProblem));
-    worhp->par.ArmijoMinAlpha = parameters.REFINE_ARMIJO_MIN_ALPHA;
-    worhp->par.ArmijoBeta = parameters.REFINE_ARMIJO_BETA;
-    worhp->par.ArmijoBetaAres = parameters.REFINE_ARMIJO_BETA;
-    worhp->par.KeepAcceptableSol = false;
-    worhp->par.LowPassFilter = false;
-    worhp->par.MaxIter = std::numeric_limits<int>::max();
-    worhp->par.LineSearchMethod = 1;  // use merit function instead of filter
-    worhp->par.TolFeas = 1e-20;
-    worhp->par.TolOpti = 1e-20;
+    // every thread has its own problem, as the parameters differ from point to point
+    size_t const num_threads = threadPool.GetNumThreads();
+    std::vector<CombinedMONLP> combinedProblems;
+    combinedProblems.reserve(num_threads);
+    std::vector<std::unique_ptr<WorhpSolver>> worhp;
+    worhp.reserve(num_threads);
+    for (size_t thread_index = 0; thread_index < num_threads; thread_index += 1)
+    {
+        combinedProblems.emplace_back(monlp, scalings);
+        worhp.push_back(solverPool.Acquire(combinedProblems.back()));
+    }
 
     std::vector<Point> new_points;
-    std::vector<double> x;
-    std::vector<double> lambda;
-    std::vector<double> mu;
-    std::vector<double> penalties;
-    double step_length;
+    std::vector<SolveResult> results;
+    threadPool.ResetStatistics();
 
     for (int step = 0; step < parameters.REFINE_MAX_STEPS; step += 1)
     {
+        std::vector<size_t> const unstopped = GetUnstoppedPoints();
+        results.clear();
+        results.resize(unstopped.size());
+        threadPool.ParallelFor(unstopped.size(), [&](size_t const task_index, size_t const thread_index)
+        {
+            RefineFromPoint(paretoFront.begin()[unstopped[task_index]], combinedProblems[thread_index],
+                            *worhp[thread_index], results[task_index]);
+        });
+
+        // merge in the order of the serial loop, so that the front does not depend on the threads
         new_points.clear();
+        for (SolveResult &result : results)
+        {
+            std::cout << result.output;
+            std::move(result.newPoints.begin(), result.newPoints.end(), std::back_inserter(new_points));
+        }
+
         for (auto it_point = paretoFront.begin(); it_point != paretoFront.end();)
         {
             if (!it_point->IsStopped())
             {
-                // The feasibility restoration will be a bit different from what the paper does, so
-                // maybe assert that direction is descent direction for all f.
-                combinedProblem.SetParameters(it_point->GetObjectiveValues());
-                worhp->SetInitialGuess(*it_point);
-                worhp->DoMajorIter();
-
-                if (worhp->cnt.status <= TerminateError)
-                {
-                    std::cout << "RefineParetoFront: WORHP terminated with status '"
-                              << worhp->cnt.status << "'!" << std::endl;
-                }
-                else
-                {
-                    // only interested in point if worhp didnt terminate with an error
-                    x.assign(worhp->opt.X, worhp->opt.X + combinedProblem.GetNumVariables());
-                    lambda.assign(worhp->opt.Lambda, worhp->opt.Lambda + combinedProblem.GetNumVariables());
-                    mu.assign(worhp->opt.Mu, worhp->opt.Mu + combinedProblem.GetNumConstraints());
-                    double *penalty = worhp->wsp.penalty;
-                    penalties.assign(penalty, penalty + monlp.GetNumConstraints());
-                    new_points.emplace_back(x, lambda, mu, penalties, worhp->wsp.MeritNewValue, monlp);
-                    step_length = it_point->GetDistance(worhp->opt.X);
-
-                    if (worhp->cnt.status >= TerminateSuccess)
-                    {
-                        new_points.back().SetStopped(true);
-                        std::cout << "RefineParetoFront: Optimal point found, status '"
-                                  << worhp->cnt.status << "'!" << std::endl;
-                    }
-                    else if (step_length < parameters.REFINE_MIN_SEARCH_LENGTH)
-                    {
-                        if (new_points.back().IsFeasible())
-                        {
-                            new_points.back().SetStopped(true);
-                            std::cout << "RefineParetoFront: Optimal point found, search length small!" << std::endl;
-                        }
-                        else
-                        {
-                            new_points.erase(new_points.end() - 1);
-                        }
-                    }
-                }
-
                 if (it_point->IsFeasible())
                 {
                     // point was used for finding descent direction regarding combined function
@@ -338,7 +342,7 @@ void MOSQP::RefineParetoFront()
             ++it_point;
         }
 
-        int num_added = paretoFront.AddPoints(new_points);
+        int num_added = paretoFront.AddPoints(std::move(new_points));
         std::cout << "RefineParetoFront: Added " << num_added << " points" << std::endl;
         paretoFront.WriteF(log);
         if (paretoFront.AllStopped())
@@ -347,7 +351,409 @@ void MOSQP::RefineParetoFront()
         }
     }
 
-    // remove infeasible points
+    WriteUtilisation("RefineParetoFront");
+    for (size_t thread_index = 0; thread_index < num_threads; thread_index += 1)
+    {
+        solverPool.Release(combinedProblems[thread_index], std::move(worhp[thread_index]));
+    }
+
+    RemoveInfeasiblePoints();
+    paretoFront.WriteF(log);
+}
+
+void MOSQP::ConfigureSpreadSolver(WorhpSolver &solver) const
+{
+    solver.par.ArmijoMinAlpha = parameters.SPREAD_ARMIJO_MIN_ALPHA;
+    solver.par.ArmijoBeta = parameters.SPREAD_ARMIJO_BETA;
+    solver.par.ArmijoBetaAres = parameters.SPREAD_ARMIJO_BETA;
+    solver.par.KeepAcceptableSol = false;
+    solver.par.LowPassFilter = false;
+    solver.par.MaxIter = std::numeric_limits<int>::max();
+    solver.par.LineSearchMethod = 1;  // use merit function instead of filter
+    solver.par.TolFeas = 1e-20;
+    solver.par.TolOpti = 1e-20;
+}
+
+void MOSQP::ConfigureRefineSolver(WorhpSolver &solver) const
+{
+    solver.par.ArmijoMinAlpha = parameters.REFINE_ARMIJO_MIN_ALPHA;
+    solver.par.ArmijoBeta = parameters.REFINE_ARMIJO_BETA;
+    solver.par.ArmijoBetaAres = parameters.REFINE_ARMIJO_BETA;
+    solver.par.KeepAcceptableSol = false;
+    solver.par.LowPassFilter = false;
+    solver.par.MaxIter = std::numeric_limits<int>::max();
+    solver.par.LineSearchMethod = 1;  // use merit function instead of filter
+    solver.par.TolFeas = 1e-20;
+    solver.par.TolOpti = 1e-20;
+}
+
+void MOSQP::SpreadFromPoint(Point const &point, SingleMONLP const &problem, WorhpSolver &solver,
+                            SolveResult &result) const
+{
+    std::ostringstream output;
+    // The solvers go from task to task, in an order that depends on the threads, so every solve
+    // starts over instead of going on with what the last one left in the solver.
+    solver.Restart();
+    ConfigureSpreadSolver(solver);
+    solver.SetInitialGuess(point);
+    solver.DoMajorIter();
+
+    if (solver.cnt.status <= TerminateError)
+    {
+        // couldn't find step in any way so not gonna add this
+        output << "SpreadParetoFront: WORHP terminated with status '"
+               << solver.cnt.status << "'!" << std::endl;
+    }
+    else
+    {
+        double const step_length = point.GetDistance(solver.opt.X);
+        if (step_length < parameters.SPREAD_MIN_SEARCH_LENGTH)
+        {
+            // search length too small, TODO: go into feasibility restoration
+            output << "SpreadParetoFront: Search length too small!" << std::endl;
+        }
+        else
+        {
+            // everything fine, build the point right from the buffers of the solver
+            // and reuse the function values it computed last
+            std::vector<double> f(monlp.GetNumObjectives());
+            std::vector<double> g(monlp.GetNumConstraints());
+            problem.GetFunctionValues(solver.opt.X, f.data(), g.data());
+            result.newPoints.emplace_back(
+                ArrayView(solver.opt.X, monlp.GetNumVariables()),
+                ArrayView(solver.opt.Lambda, monlp.GetNumVariables()),
+                ArrayView(solver.opt.Mu, monlp.GetNumConstraints()),
+                ArrayView(solver.wsp.penalty, monlp.GetNumConstraints()),
+                f, g, solver.wsp.MeritNewValue, monlp);
+        }
+    }
+    result.output = output.str();
+}
+
+void MOSQP::RefineFromPoint(Point const &point, CombinedMONLP &combined_problem, WorhpSolver &solver,
+                            SolveResult &result) const
+{
+    std::vector<Point> &points = result.newPoints;
+    std::ostringstream output;
+
+    // The feasibility restoration will be a bit different from what the paper does, so
+    // maybe assert that direction is descent direction for all f.
+    combined_problem.SetParameters(point.GetObjectiveValues().ToVector());
+    // starts over for the same reason as "SpreadFromPoint"
+    solver.Restart();
+    ConfigureRefineSolver(solver);
+    solver.SetInitialGuess(point);
+    solver.DoMajorIter();
+
+    if (solver.cnt.status <= TerminateError)
+    {
+        output << "RefineParetoFront: WORHP terminated with status '"
+               << solver.cnt.status << "'!" << std::endl;
+    }
+    else
+    {
+        // only interested in point if worhp didnt terminate with an error
+        std::vector<double> f(monlp.GetNumObjectives());
+        std::vector<double> g(monlp.GetNumConstraints());
+        combined_problem.GetFunctionValues(solver.opt.X, f.data(), g.data());
+        points.emplace_back(ArrayView(solver.opt.X, combined_problem.GetNumVariables()),
+                            ArrayView(solver.opt.Lambda, combined_problem.GetNumVariables()),
+                            ArrayView(solver.opt.Mu, combined_problem.GetNumConstraints()),
+                            ArrayView(solver.wsp.penalty, monlp.GetNumConstraints()),
+                            f, g, solver.wsp.MeritNewValue, monlp);
+        double const step_length = point.GetDistance(solver.opt.X);
+
+        if (solver.cnt.status >= TerminateSuccess)
+        {
+            points.back().SetStopped(true);
+            output << "RefineParetoFront: Optimal point found, status '"
+                   << solver.cnt.status << "'!" << std::endl;
+        }
+        else if (step_length < parameters.REFINE_MIN_SEARCH_LENGTH)
+        {
+            if (points.back().IsFeasible())
+            {
+                points.back().SetStopped(true);
+                output << "RefineParetoFront: Optimal point found, search length small!" << std::endl;
+            }
+            else
+            {
+                points.pop_back();
+            }
+        }
+    }
+    result.output = output.str();
+}
+
+void MOSQP::SpreadAndRefinePipelined()
+{
+    paretoFront.UnstopAll();
+
+    // every thread needs the problems and solvers of both stages
+    size_t const num_objectives = monlp.GetNumObjectives();
+    size_t const num_threads = threadPool.GetNumThreads();
+    std::vector<SingleMONLP> problems;
+    problems.reserve(num_threads * num_objectives);
+    std::vector<std::unique_ptr<WorhpSolver>> spread_worhp;
+    spread_worhp.reserve(num_threads * num_objectives);
+    std::vector<CombinedMONLP> combined_problems;
+    combined_problems.reserve(num_threads);
+    std::vector<std::unique_ptr<WorhpSolver>> refine_worhp;
+    refine_worhp.reserve(num_threads);
+    for (size_t thread_index = 0; thread_index < num_threads; thread_index += 1)
+    {
+        for (size_t objective_index = 0; objective_index < num_objectives; objective_index += 1)
+        {
+            problems.emplace_back(monlp, objective_index);
+            spread_worhp.push_back(solverPool.Acquire(problems.back()));
+        }
+        combined_problems.emplace_back(monlp, scalings);
+        refine_worhp.push_back(solverPool.Acquire(combined_problems.back()));
+    }
+
+    // A job solves from a copy of a point, so the front can change while the job runs, and the
+    // handle tells whether the point is still in the front. The spread jobs of one point share
+    // the copy and "numOpenSpreadJobs", the point moves on to refinement once all of them are
+    // done. "step" counts the spread or refine steps that led to the point.
+    struct Job
+    {
+        std::shared_ptr<Point const> point;
+        ParetoFront::PointHandle handle;
+        bool refine;
+        size_t objectiveIndex;
+        int step;
+        std::shared_ptr<size_t> numOpenSpreadJobs;
+    };
+
+    // A job that ran, with the points it found, waiting to be merged into the front.
+    struct FinishedJob
+    {
+        Job job;
+        std::vector<Point> newPoints;
+    };
+
+    // "mutex" guards the front and the jobs, "output_mutex" only keeps the output of a job together.
+    // A thread puts its finished job into "finished" before it waits for "mutex", and whichever
+    // thread gets "mutex" next merges all finished jobs with one "AddPoints".
+    std::mutex mutex;
+    std::mutex output_mutex;
+    std::mutex finished_mutex;
+    std::vector<FinishedJob> finished;
+    std::condition_variable jobs_changed;
+    std::deque<Job> jobs;
+    size_t num_running = 0;
+    // set when a job threw, the other threads then stop taking jobs
+    bool failed = false;
+
+    auto const add_spread_jobs = [&](Point const &point, ParetoFront::PointHandle const handle, int const step)
+    {
+        std::shared_ptr<Point const> const copy = std::make_shared<Point const>(point);
+        std::shared_ptr<size_t> const num_open = std::make_shared<size_t>(num_objectives);
+        for (size_t objective_index = 0; objective_index < num_objectives; objective_index += 1)
+        {
+            jobs.push_back(Job{ copy, handle, false, objective_index, step, num_open });
+        }
+    };
+    auto const add_refine_job = [&](Point const &point, ParetoFront::PointHandle const handle, int const step)
+    {
+        if (step < parameters.REFINE_MAX_STEPS)
+        {
+            jobs.push_back(Job{ std::make_shared<Point const>(point), handle, true, 0, step, nullptr });
+        }
+    };
+    // after the last spread step a point goes straight to refinement
+    auto const add_jobs = [&](Point const &point, ParetoFront::PointHandle const handle, int const spread_step)
+    {
+        if (spread_step < parameters.SPREAD_MAX_STEPS)
+        {
+            add_spread_jobs(point, handle, spread_step);
+        }
+        else
+        {
+            add_refine_job(point, handle, 0);
+        }
+    };
+
+    // a point that was dropped from the front is not solved from anymore, but its open spread
+    // jobs still have to be counted down
+    auto const finish_job = [&](Job const &job)
+    {
+        bool const done_spreading = !job.refine && (*job.numOpenSpreadJobs -= 1) == 0;
+        if (job.refine || done_spreading)
+        {
+            auto const it_point = paretoFront.Find(job.handle);
+            if (it_point != paretoFront.end())
+            {
+                if (!it_point->IsFeasible())
+                {
+                    paretoFront.RemovePoint(it_point);
+                }
+                else if (done_spreading)
+                {
+                    add_refine_job(*it_point, job.handle, 0);
+                }
+            }
+        }
+    };
+    auto const merge_finished = [&]()
+    {
+        std::vector<FinishedJob> batch;
+        {
+            std::lock_guard<std::mutex> finished_lock(finished_mutex);
+            std::swap(batch, finished);
+        }
+        if (batch.empty())
+        {
+            return;
+        }
+
+        // "origins[i]" is the job that found "new_points[i]"
+        std::vector<Point> new_points;
+        std::vector<size_t> origins;
+        for (size_t job_index = 0; job_index < batch.size(); job_index += 1)
+        {
+            for (Point &new_point : batch[job_index].newPoints)
+            {
+                new_points.push_back(std::move(new_point));
+                origins.push_back(job_index);
+            }
+        }
+        std::vector<ParetoFront::PointHandle> handles;
+        paretoFront.AddPoints(std::move(new_points), handles);
+
+        for (size_t i = 0; i < handles.size(); i += 1)
+        {
+            auto const it_added = paretoFront.Find(handles[i]);
+            if (it_added == paretoFront.end())
+            {
+                continue;
+            }
+
+            Job const &job = batch[origins[i]].job;
+            if (!job.refine)
+            {
+                add_jobs(*it_added, handles[i], job.step + 1);
+            }
+            else if (!it_added->IsStopped())
+            {
+                add_refine_job(*it_added, handles[i], job.step + 1);
+            }
+        }
+        for (FinishedJob const &finished_job : batch)
+        {
+            finish_job(finished_job.job);
+        }
+    };
+
+    for (auto it_point = paretoFront.begin(); it_point != paretoFront.end(); ++it_point)
+    {
+        add_jobs(*it_point, paretoFront.GetHandle(it_point), 0);
+    }
+
+    // every thread runs one long task here, so the statistics of the pool would say little
+    std::vector<ThreadPool::ThreadStatistics> statistics(num_threads, ThreadPool::ThreadStatistics{ 0, 0, 0.0 });
+    auto const start = std::chrono::steady_clock::now();
+    threadPool.ParallelFor(num_threads, [&](size_t, size_t const thread_index)
+    {
+        SolveResult result;
+        std::unique_lock<std::mutex> lock(mutex);
+        bool running = false;
+        try
+        {
+            while (true)
+            {
+                // with no job queued and none running, no new job can come up anymore
+                jobs_changed.wait(lock, [&] { return failed || !jobs.empty() || num_running == 0; });
+                if (failed || jobs.empty())
+                {
+                    break;
+                }
+
+                Job job = std::move(jobs.front());
+                jobs.pop_front();
+                if (paretoFront.Find(job.handle) != paretoFront.end())
+                {
+                    num_running += 1;
+                    running = true;
+                    lock.unlock();
+                    auto const solve_start = std::chrono::steady_clock::now();
+                    result.newPoints.clear();
+                    if (job.refine)
+                    {
+                        RefineFromPoint(*job.point, combined_problems[thread_index], *refine_worhp[thread_index],
+                                        result);
+                    }
+                    else
+                    {
+                        size_t const index = thread_index * num_objectives + job.objectiveIndex;
+                        SpreadFromPoint(*job.point, problems[index], *spread_worhp[index], result);
+                    }
+                    statistics[thread_index].numTasks += 1;
+                    statistics[thread_index].busySeconds +=
+                        std::chrono::duration<double>(std::chrono::steady_clock::now() - solve_start).count();
+                    {
+                        std::lock_guard<std::mutex> output_lock(output_mutex);
+                        std::cout << result.output;
+                    }
+                    {
+                        std::lock_guard<std::mutex> finished_lock(finished_mutex);
+                        finished.push_back(FinishedJob{ std::move(job), std::move(result.newPoints) });
+                    }
+                    lock.lock();
+                    num_running -= 1;
+                    running = false;
+                    if (failed)
+                    {
+                        break;
+                    }
+
+                    // another thread may have merged this job already together with its own
+                    merge_finished();
+                }
+                else
+                {
+                    finish_job(job);
+                }
+                jobs_changed.notify_all();
+            }
+        }
+        catch (...)
+        {
+            // without this the other threads would wait for the failed job forever, the pool
+            // rethrows the exception once all of them returned
+            if (!lock.owns_lock())
+            {
+                lock.lock();
+            }
+            if (running)
+            {
+                num_running -= 1;
+            }
+            failed = true;
+            jobs_changed.notify_all();
+            throw;
+        }
+        jobs_changed.notify_all();
+    });
+
+    WriteUtilisation("SpreadAndRefinePipelined", statistics,
+                     std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    for (size_t thread_index = 0; thread_index < num_threads; thread_index += 1)
+    {
+        for (size_t objective_index = 0; objective_index < num_objectives; objective_index += 1)
+        {
+            size_t const index = thread_index * num_objectives + objective_index;
+            solverPool.Release(problems[index], std::move(spread_worhp[index]));
+        }
+        solverPool.Release(combined_problems[thread_index], std::move(refine_worhp[thread_index]));
+    }
+
+    RemoveInfeasiblePoints();
+    paretoFront.WriteF(log);
+}
+
+void MOSQP::RemoveInfeasiblePoints()
+{
     for (auto it_point = paretoFront.begin(); it_point != paretoFront.end();)
     {
         if (!it_point->IsFeasible())
@@ -359,8 +765,51 @@ void MOSQP::RefineParetoFront()
             ++it_point;
         }
     }
+}
 
-    paretoFront.WriteF(log);
+void MOSQP::WriteUtilisation(std::string const &stage)
+{
+    WriteUtilisation(stage, threadPool.GetStatistics(), threadPool.GetElapsedSeconds());
+}
+
+void MOSQP::WriteUtilisation(std::string const &stage, std::vector<ThreadPool::ThreadStatistics> const &statistics,
+                             double const elapsed_seconds)
+{
+    for (size_t thread_index = 0; thread_index < statistics.size(); thread_index += 1)
+    {
+        ThreadPool::ThreadStatistics const &thread_statistics = statistics[thread_index];
+        double const utilisation = (elapsed_seconds > 0) ? thread_statistics.busySeconds / elapsed_seconds : 0;
+        log << stage << ": Thread " << thread_index << " ran " << thread_statistics.numTasks
+                  << " solves (" << thread_statistics.numStolenTasks << " stolen), busy "
+                  << 100 * utilisation << "% of " << elapsed_seconds << "s" << std::endl;
+    }
+}
+
+std::vector<size_t> MOSQP::GetUnstoppedPoints() const
+{
+    // "positions[i]" is the point the loop finds at position "i" of the front
+    std::vector<size_t> positions(paretoFront.NumPoints());
+    std::iota(positions.begin(), positions.end(), 0);
+    std::vector<size_t> unstopped;
+    for (size_t i = 0; i < positions.size(); )
+    {
+        Point const &point = paretoFront.begin()[positions[i]];
+        if (!point.IsStopped())
+        {
+            unstopped.push_back(positions[i]);
+            if (!point.IsFeasible())
+            {
+                // removing it moves the last point into its place
+                positions[i] = positions.back();
+                positions.pop_back();
+                continue;
+            }
+        }
+
+        i += 1;
+    }
+
+    return unstopped;
 }
 
 } // namespace mosqp
@@ -2,8 +2,15 @@
 
 #include "ParetoFront.hpp"
 #include "Point.hpp"
+#include "ThreadPool.hpp"
+#include "../nlp_solver/SolverPool.hpp"
+#include "../nlp_solver/WorhpSolver.hpp"
+#include "../problem_formulation/CombinedMONLP.hpp"
 #include "../problem_formulation/MONLP.hpp"
+#include "../problem_formulation/SingleMONLP.hpp"
+#include <cstddef>
 #include <fstream>
+#include <string>
 #include <vector>
 
 
@@ -15,9 +22,15 @@ class Parameters
 public:
     Parameters();
     int maxPoints;
+    ArchiveType archiveType;
+    TruncationType truncationType;
+    // Where the reference point of the hypervolume truncation lies beyond the worst feasible
+    // objective-values, relative to their range. Larger values keep the extreme points longer.
+    double hypervolumeReferenceOffset;
     int numCompletionTries;
     double TOL_FEAS;
     double TOL_DOMINATION;
+    bool KEEP_VIOLATIONS;
     int SPREAD_MAX_STEPS;
     double SPREAD_ARMIJO_MIN_ALPHA;
     double SPREAD_ARMIJO_BETA;
@@ -26,6 +39,12 @@ public:
     double REFINE_ARMIJO_MIN_ALPHA;
     double REFINE_ARMIJO_BETA;
     double REFINE_MIN_SEARCH_LENGTH;
+    // Threads that solve from different points at the same time, 0 means one per hardware thread.
+    int numThreads;
+    // Instead of spreading the whole front before refining it, every point moves on to refinement
+    // as soon as it is done spreading, and new points enter the front as soon as they are found.
+    // There is no barrier between steps then, but the result depends on the timing of the threads.
+    bool pipelineStages;
 };
 
 
@@ -55,6 +74,19 @@ private:
     std::vector<double> scalings;
 
     std::ofstream log;
+    // Solvers of earlier stages and steps, reused instead of setting up WORHP again.
+    SolverPool solverPool;
+    // Runs the solves of a stage in parallel, each thread with its own problems and solvers.
+    ThreadPool threadPool;
+
+    // What one task of a stage produced, i.e. one solve from a point of the front for one
+    // objective or for the combined problem. The tasks run in parallel and their results are
+    // merged in a fixed order afterwards.
+    struct SolveResult
+    {
+        std::vector<Point> newPoints;
+        std::string output;
+    };
 
     // First solving stage as proposed in the MOSQP paper.
     // Takes the given initial points by the user and adds some more, depending
@@ -69,6 +101,25 @@ private:
     // Third solving stage.
     // Drives the spread front to Pareto optimality.
     void RefineParetoFront();
+    // Both stages at once, see "Parameters::pipelineStages".
+    void SpreadAndRefinePipelined();
+    void ConfigureSpreadSolver(WorhpSolver &solver) const;
+    void ConfigureRefineSolver(WorhpSolver &solver) const;
+    // The single solves of the stages, which write the new point and the messages to "result".
+    void SpreadFromPoint(Point const &point, SingleMONLP const &problem, WorhpSolver &solver,
+                         SolveResult &result) const;
+    void RefineFromPoint(Point const &point, CombinedMONLP &combined_problem, WorhpSolver &solver,
+                         SolveResult &result) const;
+    void RemoveInfeasiblePoints();
+    // Returns the positions of the unstopped points in the order the loops of the stages visit
+    // them. These loops remove unstopped infeasible points, which moves the last point into the
+    // gap, so this is not simply the order of the front.
+    std::vector<size_t> GetUnstoppedPoints() const;
+    // Writes how busy each thread was since the statistics of "threadPool" were last reset to
+    // "log", the console only gets the progress of the solves.
+    void WriteUtilisation(std::string const &stage);
+    void WriteUtilisation(std::string const &stage, std::vector<ThreadPool::ThreadStatistics> const &statistics,
+                          double elapsed_seconds);
 };
 
 } // namespace mosqp
@@ -1,44 +1,171 @@
 #include "ParetoFront.hpp"
+#include "ArrayView.hpp"
+#include "BiObjectiveArchive.hpp"
+#include "DominanceArchive.hpp"
+#include "Hypervolume.hpp"
+#include "IndexedMinHeap.hpp"
+#include "KdTreeArchive.hpp"
+#include "LinearArchive.hpp"
 #include "Point.hpp"
 #include <algorithm>
+#include <array>
 #include <cassert>
 #include <cstddef>
 #include <iostream>
+#include <iterator>
 #include <limits>
+#include <memory>
+#include <set>
+#include <utility>
 #include <vector>
 
 
 namespace mosqp
 {
 
-ParetoFront::ParetoFront(int const max_points, size_t const num_objectives, std::vector<Point> const points)
-    : maxPoints(max_points), objectiveSortings(num_objectives)
+bool SortingEntry::operator<(SortingEntry const &other) const
 {
-    AddPoints(points);
+    return value < other.value || (value == other.value && slot < other.slot);
+}
+
+static std::unique_ptr<DominanceArchive> CreateArchive(ArchiveType const archive_type, size_t const num_objectives)
+{
+    if (archive_type == ArchiveType::Automatic && num_objectives == 2)
+    {
+        return std::make_unique<BiObjectiveArchive>();
+    }
+    else if (archive_type == ArchiveType::KdTree ||
+             (archive_type == ArchiveType::Automatic && num_objectives >= 3))
+    {
+        return std::make_unique<KdTreeArchive>(num_objectives);
+    }
+    else
+    {
+        return std::make_unique<LinearArchive>(num_objectives);
+    }
+}
+
+ParetoFront::ParetoFront(int const max_points, size_t const num_objectives, std::vector<Point> points,
+                         ArchiveType const archive_type, TruncationType const truncation_type,
+                         double const reference_offset)
+    : maxPoints(max_points), truncationType(truncation_type), referenceOffset(reference_offset),
+      objectiveSortings(num_objectives),
+      archive(CreateArchive(archive_type, num_objectives)), knownNonDominated(true)
+{
+    AddPoints(std::move(points));
     assert(IsSortingCorrect());
 }
 
-void ParetoFront::AddPoint(Point const &new_point, bool const init)
+ParetoFront::ParetoFront(ParetoFront const &other)
+    : points(other.points), pointSlots(other.pointSlots), slotPositions(other.slotPositions),
+      freeSlots(other.freeSlots), slotGenerations(other.slotGenerations), maxPoints(other.maxPoints),
+      truncationType(other.truncationType), referenceOffset(other.referenceOffset),
+      objectiveSortings(other.objectiveSortings),
+      archive(other.archive->Clone()), knownNonDominated(other.knownNonDominated)
+{
+}
+
+ParetoFront & ParetoFront::operator=(ParetoFront const &other)
 {
-    TryInsertPoint(new_point, init);
+    points = other.points;
+    pointSlots = other.pointSlots;
+    slotPositions = other.slotPositions;
+    freeSlots = other.freeSlots;
+    slotGenerations = other.slotGenerations;
+    maxPoints = other.maxPoints;
+    truncationType = other.truncationType;
+    referenceOffset = other.referenceOffset;
+    objectiveSortings = other.objectiveSortings;
+    archive = other.archive->Clone();
+    knownNonDominated = other.knownNonDominated;
+    return *this;
+}
+
+ParetoFront::PointHandle ParetoFront::AddPoint(Point const &new_point, bool const init)
+{
+    return AddPoint(Point(new_point), init);
+}
+
+ParetoFront::PointHandle ParetoFront::AddPoint(Point &&new_point, bool const init)
+{
+    PointHandle handle = GetRejectedHandle();
+    if (TryInsertPoint(std::move(new_point), init))
+    {
+        handle = GetHandle(points.cend() - 1);
+    }
+
     if (points.size() > maxPoints)
     {
         Cleanup();
     }
 
     assert(IsSortingCorrect());
+    return handle;
 }
 
 int ParetoFront::AddPoints(std::vector<Point> const &new_points)
 {
-    int num_added = 0;
-    for (Point const &point : new_points)
+    return AddPoints(std::vector<Point>(new_points));
+}
+
+int ParetoFront::AddPoints(std::vector<Point> &&new_points)
+{
+    std::vector<PointHandle> handles;
+    return AddPoints(std::move(new_points), handles);
+}
+
+int ParetoFront::AddPoints(std::vector<Point> &&new_points, std::vector<PointHandle> &handles)
+{
+    // most candidates are usually dominated by the front, so drop those before filtering the batch
+    std::vector<size_t> candidates;
+    for (size_t i = 0; i < new_points.size(); i += 1)
+    {
+        if (!archive->IsDominated(new_points[i]))
+        {
+            candidates.push_back(i);
+        }
+    }
+
+    std::vector<size_t> const accepted = FilterNonDominated(new_points, candidates);
+    std::vector<size_t> to_remove;
+    for (size_t i : accepted)
     {
-        if (TryInsertPoint(point))
+        archive->FindDominated(new_points[i], to_remove);
+    }
+
+    // several candidates may dominate the same point
+    std::sort(to_remove.begin(), to_remove.end());
+    to_remove.erase(std::unique(to_remove.begin(), to_remove.end()), to_remove.end());
+    // updating the sorted lists one by one is cheaper unless a large part of the front changes
+    bool const rebuild_sortings = (4 * (to_remove.size() + accepted.size()) > NumPoints());
+    for (size_t slot : to_remove)
+    {
+        if (rebuild_sortings)
+        {
+            ErasePoint(slotPositions[slot]);
+        }
+        else
         {
-            num_added += 1;
+            RemovePoint(slotPositions[slot]);
         }
     }
+    handles.assign(new_points.size(), GetRejectedHandle());
+    for (size_t i : accepted)
+    {
+        if (rebuild_sortings)
+        {
+            AppendPoint(std::move(new_points[i]));
+        }
+        else
+        {
+            InsertPoint(std::move(new_points[i]));
+        }
+        handles[i] = GetHandle(points.cend() - 1);
+    }
+    if (rebuild_sortings)
+    {
+        RebuildSortings();
+    }
 
     if (points.size() > maxPoints)
     {
@@ -46,37 +173,42 @@ int ParetoFront::AddPoints(std::vector<Point> const &new_points)
     }
 
     assert(IsSortingCorrect());
-    return num_added;
+    return static_cast<int>(accepted.size());
 }
 
 std::vector<Point>::iterator ParetoFront::RemovePoint(std::vector<Point>::const_iterator it)
 {
-    size_t const index = it - points.begin();
-    std::vector<Point>::iterator new_it = points.erase(it);
-    for (std::vector<size_t> &sorting : objectiveSortings)
+    size_t const index = it - points.cbegin();
+    size_t const slot = pointSlots[index];
+    size_t objective_index = 0;
+    for (std::set<SortingEntry> &sorting : objectiveSortings)
     {
-        for (std::vector<size_t>::iterator it = sorting.begin(); it != sorting.end(); it += 1)
-        {
-            if (*it == index)
-            {
-                sorting.erase(it);
-                break;
-            }
-        }
-
-        for (size_t &entry : sorting)
-        {
-            if (entry > index)
-            {
-                entry -= 1;
-            }
-        }
-
-        assert(points.size() == sorting.size());
+        sorting.erase(SortingEntry{ it->GetObjectiveValue(objective_index), slot });
+        objective_index += 1;
     }
+    ErasePoint(index);
 
     assert(IsSortingCorrect());
-    return new_it;
+    return points.begin() + index;
+}
+
+void ParetoFront::ErasePoint(size_t const index)
+{
+    size_t const slot = pointSlots[index];
+    archive->Remove(slot, points[index]);
+
+    // move the last point into the gap so that no other slot has to be touched
+    size_t const last_index = points.size() - 1;
+    if (index != last_index)
+    {
+        points[index] = std::move(points[last_index]);
+        pointSlots[index] = pointSlots[last_index];
+        slotPositions[pointSlots[index]] = index;
+    }
+    points.pop_back();
+    pointSlots.pop_back();
+    freeSlots.push_back(slot);
+    slotGenerations[slot] += 1;
 }
 
 bool ParetoFront::IsFull() const
@@ -122,6 +254,27 @@ size_t ParetoFront::GetNumFeasible() const
     return num_feasible;
 }
 
+ParetoFront::PointHandle ParetoFront::GetHandle(std::vector<Point>::const_iterator const it) const
+{
+    size_t const slot = pointSlots[it - points.cbegin()];
+    return PointHandle{ slot, slotGenerations[slot] };
+}
+
+ParetoFront::PointHandle ParetoFront::GetRejectedHandle()
+{
+    // a slot that never existed, so that "Find" does not find a rejected point
+    return PointHandle{ std::numeric_limits<size_t>::max(), 0 };
+}
+
+std::vector<Point>::const_iterator ParetoFront::Find(PointHandle const handle) const
+{
+    if (handle.slot >= slotPositions.size() || slotGenerations[handle.slot] != handle.generation)
+    {
+        return points.cend();
+    }
+    return points.cbegin() + slotPositions[handle.slot];
+}
+
 std::vector<Point>::const_iterator ParetoFront::begin() const
 {
     return points.begin();
@@ -142,50 +295,134 @@ std::vector<Point>::const_iterator ParetoFront::cend() const
     return points.cend();
 }
 
-bool ParetoFront::TryInsertPoint(Point const &new_point, bool const init)
+bool ParetoFront::TryInsertPoint(Point &&new_point, bool const init)
 {
-    std::vector<size_t> to_remove;
-    size_t const length = points.size();
-
-    // iterate backwards so that removing the points by index will
-    // be easy afterwards
-    for (size_t i = length; i > 0;)
+    if (!init)
     {
-        i -= 1;
-        if (!init && new_point.IsDominated(points[i]))
+        if (archive->IsDominated(new_point))
         {
-            new_point.IsDominated(points[i]);
             return false;
         }
-        else if (!init && points[i].IsDominated(new_point))
+
+        std::vector<size_t> to_remove;
+        archive->FindDominated(new_point, to_remove);
+        for (size_t slot : to_remove)
         {
-            to_remove.push_back(i);
+            RemovePoint(slotPositions[slot]);
         }
     }
-
-    for (size_t i : to_remove)
+    else if (knownNonDominated)
     {
-        RemovePoint(i);
+        std::vector<size_t> dominated;
+        archive->FindDominated(new_point, dominated);
+        knownNonDominated = dominated.empty() && !archive->IsDominated(new_point);
     }
 
-    InsertPoint(new_point);
+    InsertPoint(std::move(new_point));
     return true;
 }
 
-void ParetoFront::InsertPoint(Point const new_point)
+void ParetoFront::InsertPoint(Point &&new_point)
 {
-    std::vector<std::vector<size_t>::const_iterator> sorting = GetSortedIndices(new_point);
-    size_t const new_point_index = points.size();
+    size_t const slot = AppendPoint(std::move(new_point));
+    Point const &point = points.back();
     size_t const length = objectiveSortings.size();
-
-    points.push_back(new_point);
     for (size_t i = 0; i < length; i += 1)
     {
-        objectiveSortings[i].insert(sorting[i], new_point_index);
+        objectiveSortings[i].insert(SortingEntry{ point.GetObjectiveValue(i), slot });
         assert(points.size() == objectiveSortings[i].size());
     }
 }
 
+size_t ParetoFront::AppendPoint(Point &&new_point)
+{
+    size_t slot;
+    if (freeSlots.empty())
+    {
+        slot = slotPositions.size();
+        slotPositions.push_back(points.size());
+        slotGenerations.push_back(0);
+    }
+    else
+    {
+        slot = freeSlots.back();
+        freeSlots.pop_back();
+        slotPositions[slot] = points.size();
+    }
+
+    archive->Insert(slot, new_point);
+    points.push_back(std::move(new_point));
+    pointSlots.push_back(slot);
+    return slot;
+}
+
+void ParetoFront::RebuildSortings()
+{
+    std::vector<SortingEntry> entries(points.size());
+    size_t const length = objectiveSortings.size();
+    for (size_t i = 0; i < length; i += 1)
+    {
+        for (size_t j = 0; j < points.size(); j += 1)
+        {
+            entries[j] = SortingEntry{ points[j].GetObjectiveValue(i), pointSlots[j] };
+        }
+        // building a set from a sorted range takes linear time
+        std::sort(entries.begin(), entries.end());
+        objectiveSortings[i] = std::set<SortingEntry>(entries.cbegin(), entries.cend());
+    }
+}
+
+std::vector<size_t> ParetoFront::FilterNonDominated(std::vector<Point> const &new_points,
+                                                    std::vector<size_t> const &candidates) const
+{
+    // A point can only be dominated by points that are lexicographically not greater, so in
+    // lexicographic order every point only has to be checked against the kept points before it.
+    // Those it dominates in turn can only be equal in all objectives.
+    std::vector<size_t> order(candidates);
+    std::sort(order.begin(), order.end(), [&](size_t const a, size_t const b)
+    {
+        ArrayView const f_a = new_points[a].GetObjectiveValues();
+        ArrayView const f_b = new_points[b].GetObjectiveValues();
+        if (std::lexicographical_compare(f_a.cbegin(), f_a.cend(), f_b.cbegin(), f_b.cend()))
+        {
+            return true;
+        }
+        return std::equal(f_a.cbegin(), f_a.cend(), f_b.cbegin()) && a < b;
+    });
+
+    std::unique_ptr<DominanceArchive> kept = CreateArchive(ArchiveType::Automatic, objectiveSortings.size());
+    std::vector<bool> is_kept(new_points.size(), false);
+    std::vector<size_t> dominated;
+    for (size_t i : order)
+    {
+        if (kept->IsDominated(new_points[i]))
+        {
+            continue;
+        }
+
+        dominated.clear();
+        kept->FindDominated(new_points[i], dominated);
+        for (size_t j : dominated)
+        {
+            kept->Remove(j, new_points[j]);
+            is_kept[j] = false;
+        }
+        kept->Insert(i, new_points[i]);
+        is_kept[i] = true;
+    }
+
+    // keep the order of the batch
+    std::vector<size_t> indices;
+    for (size_t i : candidates)
+    {
+        if (is_kept[i])
+        {
+            indices.push_back(i);
+        }
+    }
+    return indices;
+}
+
 void ParetoFront::RemovePoint(size_t const index)
 {
     RemovePoint(points.begin() + index);
@@ -193,90 +430,387 @@ void ParetoFront::RemovePoint(size_t const index)
 
 void ParetoFront::Cleanup()
 {
-    std::vector<double> crowding_distance = ComputeCrowdingDistances();
-    std::vector<double>::iterator min_element;
+    size_t const num_objectives = objectiveSortings.size();
+    if (truncationType == TruncationType::Hypervolume && (num_objectives == 2 || num_objectives == 3))
+    {
+        CleanupHypervolume();
+    }
+    else
+    {
+        CleanupCrowdingDistance();
+    }
+}
+
+void ParetoFront::CleanupCrowdingDistance()
+{
+    // feasible points are only removed if there are enough of them to fill the front
+    size_t num_feasible = GetNumFeasible();
+    bool feasible_infinite = (num_feasible < maxPoints);
+    IndexedMinHeap heap;
+    FillCrowdingHeap(heap, feasible_infinite);
+
+    std::vector<size_t> neighbours;
+    while (IsOverfilled())
+    {
+        size_t const slot = heap.Top();
+        size_t const index = slotPositions[slot];
+        heap.Pop();
+
+        bool is_boundary = false;
+        neighbours.clear();
+        size_t objective_index = 0;
+        for (std::set<SortingEntry> const &sorting : objectiveSortings)
+        {
+            auto const it = sorting.find(SortingEntry{ points[index].GetObjectiveValue(objective_index), slot });
+            if (it == sorting.cbegin() || std::next(it) == sorting.cend())
+            {
+                is_boundary = true;
+            }
+            else
+            {
+                neighbours.push_back(std::prev(it)->slot);
+                neighbours.push_back(std::next(it)->slot);
+            }
+            objective_index += 1;
+        }
+
+        if (points[index].IsFeasible())
+        {
+            num_feasible -= 1;
+        }
+        RemovePoint(index);
+
+        // removing a boundary point changes the range of its objective, which all
+        // distances are scaled by, so then recompute them all
+        if (is_boundary || feasible_infinite != (num_feasible < maxPoints))
+        {
+            feasible_infinite = (num_feasible < maxPoints);
+            heap.Clear();
+            FillCrowdingHeap(heap, feasible_infinite);
+        }
+        else
+        {
+            for (size_t neighbour : neighbours)
+            {
+                heap.Update(neighbour, ComputeCrowdingDistance(neighbour, feasible_infinite));
+            }
+        }
+    }
+}
+
+void ParetoFront::CleanupHypervolume()
+{
+    size_t const num_objectives = objectiveSortings.size();
+    std::vector<bool> contributing(slotPositions.size(), false);
+    std::set<SortingEntry> contributing_sorting;
+    std::vector<double> lower(num_objectives, std::numeric_limits<double>::infinity());
+    std::vector<double> reference(num_objectives, -std::numeric_limits<double>::infinity());
+    for (size_t i = 0; i < points.size(); i += 1)
+    {
+        if (!points[i].IsFeasible())
+        {
+            continue;
+        }
+
+        contributing[pointSlots[i]] = true;
+        if (num_objectives == 2)
+        {
+            contributing_sorting.insert(SortingEntry{ points[i].GetObjectiveValue(0), pointSlots[i] });
+        }
+        for (size_t j = 0; j < num_objectives; j += 1)
+        {
+            lower[j] = std::min(lower[j], points[i].GetObjectiveValue(j));
+            reference[j] = std::max(reference[j], points[i].GetObjectiveValue(j));
+        }
+    }
+    for (size_t j = 0; j < num_objectives; j += 1)
+    {
+        reference[j] += referenceOffset * (reference[j] - lower[j]);
+    }
+
+    // for three objectives all contributions are computed at once and kept indexed by slot, the
+    // other vectors are reused by every sweep
+    std::vector<double> contributions;
+    std::vector<double const *> objective_values;
+    std::vector<size_t> contributing_slots;
+    std::vector<double> sweep_values;
+    if (num_objectives == 3)
+    {
+        CollectContributing3D(contributing, objective_values, contributing_slots);
+        ComputeExclusiveHypervolumes3D(objective_values, reference.data(), sweep_values, true);
+        contributions.resize(slotPositions.size());
+        for (size_t slot : pointSlots)
+        {
+            contributions[slot] = -points[slotPositions[slot]].GetMaxViolation();
+        }
+        for (size_t i = 0; i < contributing_slots.size(); i += 1)
+        {
+            contributions[contributing_slots[i]] = sweep_values[i];
+        }
+    }
+
+    IndexedMinHeap heap;
+    for (size_t slot : pointSlots)
+    {
+        heap.Push(slot, (num_objectives == 3)
+                        ? contributions[slot]
+                        : ComputeHypervolumeContribution(slot, contributing, contributing_sorting, reference));
+    }
+
+    std::vector<size_t> neighbours;
+    std::array<double, 3> removed_values;
     while (IsOverfilled())
     {
-        min_element = std::min_element(crowding_distance.begin(), crowding_distance.end());
-        RemovePoint(min_element - crowding_distance.begin());
-        crowding_distance.erase(min_element);
+        size_t const slot = heap.Top();
+        size_t const index = slotPositions[slot];
+        heap.Pop();
+
+        // infeasible points don't change any contribution
+        bool const was_contributing = contributing[slot];
+        neighbours.clear();
+        if (was_contributing && num_objectives == 2)
+        {
+            auto const it = contributing_sorting.find(SortingEntry{ points[index].GetObjectiveValue(0), slot });
+            if (it != contributing_sorting.cbegin())
+            {
+                neighbours.push_back(std::prev(it)->slot);
+            }
+            if (std::next(it) != contributing_sorting.cend())
+            {
+                neighbours.push_back(std::next(it)->slot);
+            }
+            contributing_sorting.erase(it);
+        }
+        if (was_contributing && num_objectives == 3)
+        {
+            ArrayView const f = points[index].GetObjectiveValues();
+            std::copy(f.cbegin(), f.cend(), removed_values.begin());
+        }
+        contributing[slot] = false;
+        RemovePoint(index);
+
+        if (num_objectives == 2)
+        {
+            for (size_t neighbour : neighbours)
+            {
+                heap.Update(neighbour, ComputeHypervolumeContribution(neighbour, contributing, contributing_sorting,
+                                                                      reference));
+            }
+        }
+        else if (was_contributing && IsOverfilled())
+        {
+            // only the points that shared a region with the removed one alone grow
+            CollectContributing3D(contributing, objective_values, contributing_slots);
+            ComputeHypervolumeIncreases3D(removed_values.data(), objective_values, reference.data(), sweep_values,
+                                          true);
+            for (size_t i = 0; i < contributing_slots.size(); i += 1)
+            {
+                if (sweep_values[i] > 0)
+                {
+                    size_t const other_slot = contributing_slots[i];
+                    contributions[other_slot] += sweep_values[i];
+                    heap.Update(other_slot, contributions[other_slot]);
+                }
+            }
+        }
     }
 }
 
 bool ParetoFront::AllNonDominated() const
 {
-    size_t const num_points = NumPoints();
-    for (size_t i = 0; i < num_points; i += 1)
+    if (!knownNonDominated)
     {
-        for (size_t j = i + 1; j < num_points; j += 1)
+        knownNonDominated = SweepAllNonDominated();
+    }
+
+    // only the bookkeeping of the inserts says so, debug builds make sure with a sweep
+    assert(!knownNonDominated || SweepAllNonDominated());
+    return knownNonDominated;
+}
+
+bool ParetoFront::SweepAllNonDominated() const
+{
+    return (objectiveSortings.size() == 2) ? SweepNonDominatedBiObjective() : SweepNonDominated();
+}
+
+bool ParetoFront::SweepNonDominatedBiObjective() const
+{
+    // the points before are kept in a Fenwick tree over the ranks of their f2-values, which gives
+    // the smallest violation of all points before with an f2-value not greater than a given one
+    std::vector<double> f2_values;
+    f2_values.reserve(NumPoints());
+    for (Point const &point : points)
+    {
+        f2_values.push_back(point.GetObjectiveValue(1));
+    }
+    std::sort(f2_values.begin(), f2_values.end());
+    f2_values.erase(std::unique(f2_values.begin(), f2_values.end()), f2_values.end());
+    std::vector<double> min_violations(f2_values.size() + 1, std::numeric_limits<double>::infinity());
+
+    std::set<SortingEntry> const &sorting = objectiveSortings[0];
+    for (auto group_begin = sorting.cbegin(); group_begin != sorting.cend();)
+    {
+        auto group_end = group_begin;
+        while (group_end != sorting.cend() && group_end->value == group_begin->value)
         {
-            if (points[i].IsDominated(points[j]) || points[j].IsDominated(points[i]))
+            ++group_end;
+        }
+
+        for (auto it = group_begin; it != group_end; ++it)
+        {
+            Point const &point = points[slotPositions[it->slot]];
+            double min_violation = std::numeric_limits<double>::infinity();
+            size_t rank = std::upper_bound(f2_values.cbegin(), f2_values.cend(), point.GetObjectiveValue(1)) -
+                          f2_values.cbegin();
+            for (; rank > 0; rank -= rank & (~rank + 1))
+            {
+                min_violation = std::min(min_violation, min_violations[rank]);
+            }
+            if (!(point.GetMaxViolation() < min_violation - Point::TOL_FEAS))
             {
                 return false;
             }
+
+            for (auto other = std::next(it); other != group_end; ++other)
+            {
+                Point const &other_point = points[slotPositions[other->slot]];
+                if (point.IsDominated(other_point) || other_point.IsDominated(point))
+                {
+                    return false;
+                }
+            }
         }
+
+        for (auto it = group_begin; it != group_end; ++it)
+        {
+            Point const &point = points[slotPositions[it->slot]];
+            double const max_violation = point.GetMaxViolation();
+            size_t rank = std::lower_bound(f2_values.cbegin(), f2_values.cend(), point.GetObjectiveValue(1)) -
+                          f2_values.cbegin() + 1;
+            for (; rank < min_violations.size(); rank += rank & (~rank + 1))
+            {
+                min_violations[rank] = std::min(min_violations[rank], max_violation);
+            }
+        }
+        group_begin = group_end;
     }
 
     return true;
 }
 
-std::vector<std::vector<size_t>::const_iterator> ParetoFront::GetSortedIndices(Point const &point) const
+bool ParetoFront::SweepNonDominated() const
 {
-    size_t const num_objectives = objectiveSortings.size();
-    std::vector<std::vector<size_t>::const_iterator> indices(num_objectives);
-    for (size_t i = 0; i < num_objectives; i += 1)
+    KdTreeArchive swept(objectiveSortings.size());
+    std::set<SortingEntry> const &sorting = objectiveSortings[0];
+    for (auto group_begin = sorting.cbegin(); group_begin != sorting.cend();)
     {
-        for (indices[i] = objectiveSortings[i].begin(); indices[i] != objectiveSortings[i].end(); indices[i] += 1)
+        auto group_end = group_begin;
+        while (group_end != sorting.cend() && group_end->value == group_begin->value)
         {
-            if (point.IsSmaller(points[*indices[i]], i))
+            ++group_end;
+        }
+
+        for (auto it = group_begin; it != group_end; ++it)
+        {
+            Point const &point = points[slotPositions[it->slot]];
+            if (swept.IsDominated(point))
+            {
+                return false;
+            }
+
+            for (auto other = std::next(it); other != group_end; ++other)
             {
-                break;
+                Point const &other_point = points[slotPositions[other->slot]];
+                if (point.IsDominated(other_point) || other_point.IsDominated(point))
+                {
+                    return false;
+                }
             }
         }
+
+        for (auto it = group_begin; it != group_end; ++it)
+        {
+            swept.Insert(it->slot, points[slotPositions[it->slot]]);
+        }
+        group_begin = group_end;
     }
 
-    return indices;
+    return true;
 }
 
-std::vector<double> ParetoFront::ComputeCrowdingDistances() const
+double ParetoFront::ComputeCrowdingDistance(size_t const slot, bool const feasible_infinite) const
 {
-    std::vector<double> distances(NumPoints());
-    std::fill_n(distances.begin(), NumPoints(), 0);
-    size_t const num_objectives = objectiveSortings.size();
-    size_t const num_points = NumPoints();
-    double max_distance;
+    Point const &point = points[slotPositions[slot]];
+    if (feasible_infinite && point.IsFeasible())
+    {
+        return std::numeric_limits<double>::infinity();
+    }
 
+    double distance = 0;
     size_t objective_index = 0;
-    for (std::vector<size_t> const &objective_sorting : objectiveSortings)
+    for (std::set<SortingEntry> const &sorting : objectiveSortings)
     {
-        distances[objective_sorting.front()] = std::numeric_limits<double>::infinity();
-        distances[objective_sorting.back()] = std::numeric_limits<double>::infinity();
-        max_distance = (points[objective_sorting.back()].GetObjectiveValue(objective_index) -
-                        points[objective_sorting.front()].GetObjectiveValue(objective_index));
-        assert(max_distance >= 0);
-
-        for (auto it = objective_sorting.cbegin() + 1; it != objective_sorting.cend() - 1; it += 1)
+        auto const it = sorting.find(SortingEntry{ point.GetObjectiveValue(objective_index), slot });
+        if (it == sorting.cbegin() || std::next(it) == sorting.cend())
         {
-            distances[*it] += (points[*(it + 1)].GetObjectiveValue(objective_index) -
-                               points[*(it - 1)].GetObjectiveValue(objective_index)) / max_distance;
+            return std::numeric_limits<double>::infinity();
         }
 
+        // an objective in which all points are equal doesn't tell them apart
+        double const max_distance = sorting.crbegin()->value - sorting.cbegin()->value;
+        assert(max_distance >= 0);
+        if (max_distance > 0)
+        {
+            distance += (std::next(it)->value - std::prev(it)->value) / max_distance;
+        }
         objective_index += 1;
     }
 
-    size_t const num_feasible = GetNumFeasible();
-    if (num_feasible < maxPoints)
+    return distance;
+}
+
+void ParetoFront::FillCrowdingHeap(IndexedMinHeap &heap, bool const feasible_infinite) const
+{
+    for (size_t slot : pointSlots)
+    {
+        heap.Push(slot, ComputeCrowdingDistance(slot, feasible_infinite));
+    }
+}
+
+double ParetoFront::ComputeHypervolumeContribution(size_t const slot, std::vector<bool> const &contributing,
+                                                   std::set<SortingEntry> const &contributing_sorting,
+                                                   std::vector<double> const &reference) const
+{
+    Point const &point = points[slotPositions[slot]];
+    if (!contributing[slot])
+    {
+        return -point.GetMaxViolation();
+    }
+
+    // the exclusive region is the rectangle up to the next point in f1 and the previous in f2
+    double const f1 = point.GetObjectiveValue(0);
+    double const f2 = point.GetObjectiveValue(1);
+    auto const it = contributing_sorting.find(SortingEntry{ f1, slot });
+    double const next_f1 = (std::next(it) == contributing_sorting.cend()) ? reference[0] : std::next(it)->value;
+    double const prev_f2 = (it == contributing_sorting.cbegin())
+                           ? reference[1] : points[slotPositions[std::prev(it)->slot]].GetObjectiveValue(1);
+    return std::max(0.0, (next_f1 - f1) * (prev_f2 - f2));
+}
+
+void ParetoFront::CollectContributing3D(std::vector<bool> const &contributing,
+                                        std::vector<double const *> &objective_values,
+                                        std::vector<size_t> &slots) const
+{
+    objective_values.clear();
+    slots.clear();
+    for (SortingEntry const &entry : objectiveSortings[2])
     {
-        for (size_t i = 0; i < num_points; i += 1)
+        if (contributing[entry.slot])
         {
-            if (points[i].IsFeasible())
-            {
-                distances[i] = std::numeric_limits<double>::infinity();
-            }
+            objective_values.push_back(points[slotPositions[entry.slot]].GetObjectiveValues().data());
+            slots.push_back(entry.slot);
         }
     }
-
-    return distances;
 }
 
 bool ParetoFront::IsOverfilled() const
@@ -318,13 +852,27 @@ void ParetoFront::WriteF(std::ostream &stream)
 
 bool ParetoFront::IsSortingCorrect() const
 {
+    // the trees keep the entries sorted by value, so it suffices to check that every
+    // entry refers to a point and carries that point's current objective-value
+    if (pointSlots.size() != points.size() || slotPositions.size() != points.size() + freeSlots.size() ||
+        slotGenerations.size() != slotPositions.size())
+    {
+        return false;
+    }
+
     size_t objective_index = 0;
-    for (std::vector<size_t> const &objective_sorting : objectiveSortings)
+    for (std::set<SortingEntry> const &objective_sorting : objectiveSortings)
     {
-        for (int i = 1; i < objective_sorting.size(); i += 1)
+        if (objective_sorting.size() != points.size())
+        {
+            return false;
+        }
+
+        for (SortingEntry const &entry : objective_sorting)
         {
-            if (points[objective_sorting[i]].GetObjectiveValue(objective_index) <
-                points[objective_sorting[i - 1]].GetObjectiveValue(objective_index))
+            size_t const index = slotPositions[entry.slot];
+            if (index >= points.size() || pointSlots[index] != entry.slot ||
+                entry.value != points[index].GetObjectiveValue(objective_index))
             {
                 return false;
             }
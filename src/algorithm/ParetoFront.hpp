@@ -1,21 +1,89 @@
 #pragma once
 
+#include "DominanceArchive.hpp"
+#include "IndexedMinHeap.hpp"
 #include "Point.hpp"
 #include <cstddef>
+#include <memory>
 #include <ostream>
+#include <set>
 #include <vector>
 
 
 namespace mosqp
 {
 
+// Entry of the sorted lists in "ParetoFront::objectiveSortings". Entries are ordered by the
+// objective-value first and by the slot of the point second, so that points with equal
+// objective-values can still be told apart.
+struct SortingEntry
+{
+    double value;
+    size_t slot;
+
+    bool operator<(SortingEntry const &other) const;
+};
+
+
+// Which "DominanceArchive" a "ParetoFront" uses. "Automatic" picks the staircase for two
+// objectives, the k-d tree for three or more and the linear scan otherwise.
+enum class ArchiveType
+{
+    Automatic,
+    Linear,
+    KdTree
+};
+
+
+// How "ParetoFront::Cleanup" decides which points to remove. "Hypervolume" removes the point
+// with the smallest exclusive hypervolume contribution and is available for two and three
+// objectives, for more objectives the crowding distance is used anyway. Removing k of n points
+// takes O(n log n) for two objectives. For three it takes O(n log n) for the first contributions
+// and then a sweep over the points for every removal, which finds the few points that grow in
+// close to O(n), so O(n log n + k n) in total (O((k + 1) n log n) at worst).
+enum class TruncationType
+{
+    CrowdingDistance,
+    Hypervolume
+};
+
+
 class ParetoFront
 {
 public:
-    ParetoFront(int max_points, size_t num_objectives, std::vector<Point> points);
+    // Identifies a point for as long as it is in the front. A slot is reused once its point is
+    // removed, the generation tells the points that had the slot apart.
+    struct PointHandle
+    {
+        size_t slot;
+        size_t generation;
+    };
+
+    // See "referenceOffset" for the last argument.
+    ParetoFront(int max_points, size_t num_objectives, std::vector<Point> points,
+                ArchiveType archive_type = ArchiveType::Automatic,
+                TruncationType truncation_type = TruncationType::CrowdingDistance,
+                double reference_offset = 0.1);
+    ParetoFront(ParetoFront const &other);
+    ParetoFront & operator=(ParetoFront const &other);
 
-    void AddPoint(Point const &new_point, bool init = false);
+    // The overloads taking an rvalue move the point into the front instead of copying it.
+    // The returned handle finds the point as long as it is in the front, "Find" returns "end()"
+    // for it if the point was rejected.
+    PointHandle AddPoint(Point const &new_point, bool init = false);
+    PointHandle AddPoint(Point &&new_point, bool init = false);
+    // Adds a batch of points at once. The points not dominated by the front are reduced to those
+    // not dominated by another point of the batch. Then the points of the front they dominate
+    // are removed, the sorted lists are updated in one go and "Cleanup()" runs once.
+    // Returns the number of points from the batch that made it into the front.
     int AddPoints(std::vector<Point> const &points);
+    // Same as above, but moves the accepted points out of the batch. The batch is left in an
+    // unspecified state and should be cleared before it is reused.
+    int AddPoints(std::vector<Point> &&points);
+    // Same as above, and sets "handles[i]" to the handle of "points[i]" as "AddPoint" returns it.
+    int AddPoints(std::vector<Point> &&points, std::vector<PointHandle> &handles);
+    // Removes the point in O(log n). The last point is moved into its place and the returned
+    // iterator points to it, so iterating on from there still visits every point once.
     std::vector<Point>::iterator RemovePoint(std::vector<Point>::const_iterator it);
     // set all points unstopped
     void UnstopAll();
@@ -23,6 +91,9 @@ public:
     bool IsFull() const;
     bool AllStopped() const;
     bool AllFeasible() const;
+    // Whether no point in the front dominates another one. Inserting with dominance checks keeps
+    // the front non-dominated, so this only has to sweep over the points after "init" inserts.
+    // Debug builds sweep every time to check that.
     bool AllNonDominated() const;
     size_t GetNumFeasible() const;
     size_t NumPoints() const;
@@ -31,6 +102,10 @@ public:
     void WriteX(std::ostream &stream);
     void WriteF(std::ostream &stream);
 
+    PointHandle GetHandle(std::vector<Point>::const_iterator it) const;
+    // Returns the point the handle belongs to in O(1), or "end()" if it is not in the front anymore.
+    std::vector<Point>::const_iterator Find(PointHandle handle) const;
+
     // Provides access to the points with iterators.
     std::vector<Point>::const_iterator begin() const;
     std::vector<Point>::const_iterator end() const;
@@ -38,37 +113,99 @@ public:
     std::vector<Point>::const_iterator cend() const;
 
 private:
-    // The current points in the Pareto front.
+    // The current points in the Pareto front. Removing a point moves the last one into its
+    // place, so the points stay contiguous but their order is not preserved.
     std::vector<Point> points;
+    // Every point owns a slot that stays the same for as long as the point is in the front,
+    // no matter where in "points" it is moved to. "pointSlots" maps positions in "points" to
+    // slots, "slotPositions" maps slots back to positions. Unused slots are kept in "freeSlots".
+    // "slotGenerations" counts how often each slot was freed, see "PointHandle".
+    std::vector<size_t> pointSlots;
+    std::vector<size_t> slotPositions;
+    std::vector<size_t> freeSlots;
+    std::vector<size_t> slotGenerations;
     // The maximum number of points we want to store in this front. Note that "points.size()"
     // can exceed this number before being brought back by the "Cleanup()" function.
     size_t maxPoints;
-    // Foreach objective-function this contains a list of indices to the "points"-vector.
-    // The indices are sorted in ascending order by the objective-value of the corresponding point.
-    std::vector<std::vector<size_t>> objectiveSortings;
+    TruncationType truncationType;
+    // How far the reference point of the hypervolume truncation lies beyond the worst feasible
+    // objective-values, relative to their range. The points at the boundary of an objective only
+    // contribute the slab between them and the reference point in that objective, so the larger
+    // this is, the longer the extreme points of the front are kept. With zero they contribute
+    // nothing and are removed first.
+    double referenceOffset;
+    // Foreach objective-function this contains the slots of all points, sorted in ascending order
+    // by the objective-value of the corresponding point. Kept in balanced search trees so that
+    // inserting, finding and removing a point takes O(log n).
+    std::vector<std::set<SortingEntry>> objectiveSortings;
+    // Answers the dominance queries when inserting a point. Chosen by the number of objectives.
+    std::unique_ptr<DominanceArchive> archive;
+    // Set when no point in the front is known to dominate another one. Only inserting with
+    // "init == true" can break this, verifying the front with a sweep sets it again.
+    mutable bool knownNonDominated;
 
     // Tries to insert the given point into the Pareto front. If it is dominated by a point in
     // the front it will not be inserted. Also removes any points that are in the front and are
     // dominated by the new point if it gets inserted.
     // Ignores domination when init == true
     // Returns whether the point was inserted or not
-    bool TryInsertPoint(Point const &new_point, bool init = false);
+    bool TryInsertPoint(Point &&new_point, bool init = false);
+    // The handle returned for a point that did not make it into the front.
+    static PointHandle GetRejectedHandle();
     // Inserts the point into the Pareto front while also updating
     // the sorted lists in "objectiveSortings".
-    void InsertPoint(Point new_point);
-    // Removes the point from the Pareto front while also updating
-    // the sorted lists in "objectiveSortings".
+    void InsertPoint(Point &&new_point);
+    // Removes the point at the given position from the Pareto front while also updating
+    // the sorted lists in "objectiveSortings". The last point is moved into its position.
     void RemovePoint(size_t index);
+    // Same as "InsertPoint" and "RemovePoint" but without touching "objectiveSortings".
+    // Returns the slot of the new point.
+    size_t AppendPoint(Point &&new_point);
+    void ErasePoint(size_t index);
+    // Sorts all points into "objectiveSortings" from scratch.
+    void RebuildSortings();
+    // Returns those of the given indices into the batch whose points are not dominated by the
+    // point of another of the indices, keeping only the first one of equal points.
+    std::vector<size_t> FilterNonDominated(std::vector<Point> const &new_points,
+                                           std::vector<size_t> const &candidates) const;
     // Removes points from the front until the amount "maxPoints" is not exceeded anymore.
-    // Uses a crowding distance to decide which points to remove.
+    // Uses the strategy given by "truncationType".
     void Cleanup();
+    // Repeatedly removes the point with the smallest crowding distance. The distances are kept
+    // in a heap and after each removal only those of the removed point's neighbours are updated.
+    void CleanupCrowdingDistance();
+    // Removes the infeasible points with the largest violation first, then repeatedly the feasible
+    // point with the smallest exclusive hypervolume contribution. The reference point is fixed for
+    // the whole cleanup, see "referenceOffset". For two objectives a removal only updates the two
+    // neighbours of the removed point, for three one sweep finds how much each point grows.
+    void CleanupHypervolume();
 
-    // Gets the indices of where to put the point in "objectiveSortings".
-    std::vector<std::vector<size_t>::const_iterator> GetSortedIndices(Point const &point) const;
-    // Computes the crowding distance of all points in the front.
-    std::vector<double> ComputeCrowdingDistances() const;
+    // Computes the crowding distance of the point in the given slot. Points at the boundary of
+    // any objective get an infinite distance, and so do feasible points if "feasible_infinite".
+    double ComputeCrowdingDistance(size_t slot, bool feasible_infinite) const;
+    // Pushes the crowding distances of all points into the (empty) heap.
+    void FillCrowdingHeap(IndexedMinHeap &heap, bool feasible_infinite) const;
+    // Computes the exclusive hypervolume contribution of the point in the given slot among the
+    // points marked in "contributing" (indexed by slot), for two objectives. These are also
+    // expected in "contributing_sorting", sorted by the first objective-value. Points not marked
+    // get their negative maximum violation, so that they are removed first.
+    double ComputeHypervolumeContribution(size_t slot, std::vector<bool> const &contributing,
+                                          std::set<SortingEntry> const &contributing_sorting,
+                                          std::vector<double> const &reference) const;
+    // Collects the objective-values and slots of the points marked in "contributing" (indexed by
+    // slot) in ascending order of the third objective-value, as the 3D sweeps take them.
+    void CollectContributing3D(std::vector<bool> const &contributing, std::vector<double const *> &objective_values,
+                               std::vector<size_t> &slots) const;
     // If there are too many points in the front
     bool IsOverfilled() const;
+    // Check whether no point dominates another one by sweeping over the points in the order of
+    // the first objective. Each point is only compared to the points before it and to those
+    // with the same first objective-value. Takes O(n log n) for two objectives.
+    bool SweepNonDominatedBiObjective() const;
+    // Same as above for any number of objectives, the points before are kept in a k-d tree.
+    bool SweepNonDominated() const;
+    // One of the two above, by the number of objectives. Ignores "knownNonDominated".
+    bool SweepAllNonDominated() const;
     // Debugging function to check whether sorting in 'objectiveSortings' is correct
     bool IsSortingCorrect() const;
 };
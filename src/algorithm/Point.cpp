@@ -1,8 +1,13 @@
 #include "Point.hpp"
+#include "ArrayView.hpp"
+#include "BlockPool.hpp"
 #include "../problem_formulation/MONLP.hpp"
 #include <algorithm>
+#include <cmath>
 #include <cstddef>
+#include <limits>
 #include <random>
+#include <utility>
 #include <vector>
 
 
@@ -11,35 +16,49 @@ namespace mosqp
 
 double Point::TOL_FEAS;
 double Point::TOL_DOMINATION;
+bool Point::KEEP_VIOLATIONS = true;
 
-Point::Point(std::vector<double> const &x, MONLP const &monlp)
-    : x(x), lambda(), mu(), stopped(false),
-      f(monlp.GetNumObjectives()), g(monlp.GetNumConstraints()),
-      cv(monlp.GetNumVariables() * 2 + monlp.GetNumConstraints() * 2),
-      penalties(), meritValue(std::numeric_limits<double>::infinity())
+Point::Point(ArrayView const x, MONLP const &monlp)
+    : block(nullptr), maxViolation(0), meritValue(std::numeric_limits<double>::infinity()), stopped(false)
 {
+    Initialize(0, 0, 0, monlp);
+    std::copy(x.cbegin(), x.cend(), GetArray(X));
     UpdateFunctionValues(monlp);
 }
 
-Point::Point(std::vector<double> const &x, std::vector<double> const &lambda,
-             std::vector<double> const &mu, std::vector<double> const &penalties,
+Point::Point(ArrayView const x, ArrayView const lambda, ArrayView const mu, ArrayView const penalties,
              double const merit_value, MONLP const &monlp)
-    : x(x), lambda(lambda), mu(mu), stopped(false),
-      f(monlp.GetNumObjectives()), g(monlp.GetNumConstraints()),
-      cv(monlp.GetNumVariables() * 2 + monlp.GetNumConstraints() * 2),
-      penalties(penalties), meritValue(merit_value)
+    : block(nullptr), maxViolation(0), meritValue(merit_value), stopped(false)
 {
+    Initialize(lambda.size(), mu.size(), penalties.size(), monlp);
+    std::copy(x.cbegin(), x.cend(), GetArray(X));
+    std::copy(lambda.cbegin(), lambda.cend(), GetArray(LAMBDA));
+    std::copy(mu.cbegin(), mu.cend(), GetArray(MU));
+    std::copy(penalties.cbegin(), penalties.cend(), GetArray(PENALTIES));
     UpdateFunctionValues(monlp);
 }
 
+Point::Point(ArrayView const x, ArrayView const lambda, ArrayView const mu, ArrayView const penalties,
+             ArrayView const f, ArrayView const g, double const merit_value, MONLP const &monlp)
+    : block(nullptr), maxViolation(0), meritValue(merit_value), stopped(false)
+{
+    Initialize(lambda.size(), mu.size(), penalties.size(), monlp);
+    std::copy(x.cbegin(), x.cend(), GetArray(X));
+    std::copy(lambda.cbegin(), lambda.cend(), GetArray(LAMBDA));
+    std::copy(mu.cbegin(), mu.cend(), GetArray(MU));
+    std::copy(penalties.cbegin(), penalties.cend(), GetArray(PENALTIES));
+    std::copy(f.cbegin(), f.cend(), GetArray(F));
+    std::copy(g.cbegin(), g.cend(), GetArray(G));
+    UpdateViolations(monlp);
+}
+
 static std::default_random_engine random_engine;
 Point::Point(std::vector<double> const &lower_bounds, std::vector<double> const &upper_bounds,
              MONLP const &monlp)
-    : x(monlp.GetNumVariables()), lambda(), mu(),
-      f(monlp.GetNumObjectives()), g(monlp.GetNumConstraints()),
-      cv(monlp.GetNumVariables() * 2 + monlp.GetNumConstraints() * 2),
-      penalties(), meritValue(std::numeric_limits<double>::infinity())
+    : block(nullptr), maxViolation(0), meritValue(std::numeric_limits<double>::infinity()), stopped(false)
 {
+    Initialize(0, 0, 0, monlp);
+    double *const x = GetArray(X);
     std::uniform_real_distribution<double> uniform_distribution;
     std::normal_distribution<double> normal_distribution;
     for (size_t i = 0; i < lower_bounds.size(); i += 1)
@@ -58,6 +77,91 @@ Point::Point(std::vector<double> const &lower_bounds, std::vector<double> const
     UpdateFunctionValues(monlp);
 }
 
+Point::Point(Point const &other)
+    : block(nullptr), maxViolation(other.maxViolation), meritValue(other.meritValue), stopped(other.stopped)
+{
+    std::copy(other.offsets, other.offsets + NUM_ARRAYS + 1, offsets);
+    block = BlockPool::Allocate(offsets[NUM_ARRAYS]);
+    std::copy(other.block, other.block + offsets[NUM_ARRAYS], block);
+}
+
+Point::Point(Point &&other) noexcept
+    : block(other.block), maxViolation(other.maxViolation), meritValue(other.meritValue), stopped(other.stopped)
+{
+    std::copy(other.offsets, other.offsets + NUM_ARRAYS + 1, offsets);
+    other.block = nullptr;
+    std::fill_n(other.offsets, NUM_ARRAYS + 1, 0);
+}
+
+Point & Point::operator=(Point const &other)
+{
+    if (this != &other)
+    {
+        // keep the block if it has the right size already
+        if (offsets[NUM_ARRAYS] != other.offsets[NUM_ARRAYS])
+        {
+            BlockPool::Free(block, offsets[NUM_ARRAYS]);
+            block = BlockPool::Allocate(other.offsets[NUM_ARRAYS]);
+        }
+        std::copy(other.offsets, other.offsets + NUM_ARRAYS + 1, offsets);
+        std::copy(other.block, other.block + offsets[NUM_ARRAYS], block);
+        maxViolation = other.maxViolation;
+        meritValue = other.meritValue;
+        stopped = other.stopped;
+    }
+    return *this;
+}
+
+Point & Point::operator=(Point &&other) noexcept
+{
+    std::swap(block, other.block);
+    std::swap(offsets, other.offsets);
+    maxViolation = other.maxViolation;
+    meritValue = other.meritValue;
+    stopped = other.stopped;
+    return *this;
+}
+
+Point::~Point()
+{
+    BlockPool::Free(block, offsets[NUM_ARRAYS]);
+}
+
+void Point::Allocate(size_t const (&sizes)[NUM_ARRAYS])
+{
+    offsets[0] = 0;
+    for (size_t i = 0; i < NUM_ARRAYS; i += 1)
+    {
+        offsets[i + 1] = offsets[i] + sizes[i];
+    }
+    block = BlockPool::Allocate(offsets[NUM_ARRAYS]);
+}
+
+double * Point::GetArray(Array const array)
+{
+    return block + offsets[array];
+}
+
+double const * Point::GetArray(Array const array) const
+{
+    return block + offsets[array];
+}
+
+size_t Point::GetSize(Array const array) const
+{
+    return offsets[array + 1] - offsets[array];
+}
+
+void Point::Initialize(size_t const num_lambda, size_t const num_mu, size_t const num_penalties,
+                       MONLP const &monlp)
+{
+    size_t const num_variables = monlp.GetNumVariables();
+    size_t const num_constraints = monlp.GetNumConstraints();
+    size_t const num_violations = KEEP_VIOLATIONS ? num_variables * 2 + num_constraints * 2 : 0;
+    Allocate({ num_variables, num_lambda, num_mu, num_penalties, monlp.GetNumObjectives(), num_constraints,
+               num_violations });
+}
+
 void Point::SetStopped(bool const stopped) const
 {
     this->stopped = stopped;
@@ -65,70 +169,91 @@ void Point::SetStopped(bool const stopped) const
 
 void Point::UpdateFunctionValues(MONLP const &monlp)
 {
-    monlp.EvalF(x.data(), f.data());
+    double const *const x = GetArray(X);
+    monlp.EvalFG(x, GetArray(F), GetArray(G));
+    UpdateViolations(monlp);
+}
 
+void Point::UpdateViolations(MONLP const &monlp)
+{
+    double const *const x = GetArray(X);
+    double const *const g = GetArray(G);
     size_t const num_constraints = monlp.GetNumConstraints();
     size_t const num_variables = monlp.GetNumVariables();
-    g = std::vector<double>(num_constraints);
     std::vector<double> const &g_l = monlp.GetGL();
     std::vector<double> const &g_u = monlp.GetGU();
     std::vector<double> const &x_l = monlp.GetXL();
     std::vector<double> const &x_u = monlp.GetXU();
-    monlp.EvalG(x.data(), g.data());
 
-    size_t j = 0;
-    for (size_t i = 0; i < num_variables; i += 1)
+    if (GetSize(VIOLATIONS) != 0)
     {
-        cv[j++] = std::max(x_l[i] - x[i], 0.0);
-        cv[j++] = std::max(x[i] - x_u[i], 0.0);
+        double *const cv = GetArray(VIOLATIONS);
+        size_t j = 0;
+        for (size_t i = 0; i < num_variables; i += 1)
+        {
+            cv[j++] = std::max(x_l[i] - x[i], 0.0);
+            cv[j++] = std::max(x[i] - x_u[i], 0.0);
+        }
+
+        for (size_t i = 0; i < num_constraints; i += 1)
+        {
+            cv[j++] = std::max(g_l[i] - g[i], 0.0);
+            cv[j++] = std::max(g[i] - g_u[i], 0.0);
+        }
     }
 
+    maxViolation = 0;
+    for (size_t i = 0; i < num_variables; i += 1)
+    {
+        maxViolation = std::max(maxViolation, std::max(x_l[i] - x[i], x[i] - x_u[i]));
+    }
     for (size_t i = 0; i < num_constraints; i += 1)
     {
-        cv[j++] = std::max(g_l[i] - g[i], 0.0);
-        cv[j++] = std::max(g[i] - g_u[i], 0.0);
+        maxViolation = std::max(maxViolation, std::max(g_l[i] - g[i], g[i] - g_u[i]));
     }
 }
 
 double Point::GetObjectiveValue(size_t const objective_index) const
 {
-    return f[objective_index];
+    return GetArray(F)[objective_index];
 }
 
-std::vector<double> const & Point::GetObjectiveValues() const
+ArrayView Point::GetObjectiveValues() const
 {
-    return f;
+    return ArrayView(GetArray(F), GetSize(F));
 }
 
-std::vector<double> const & Point::GetX() const
+ArrayView Point::GetX() const
 {
-    return x;
+    return ArrayView(GetArray(X), GetSize(X));
 }
 
-std::vector<double> const & Point::GetLambda() const
+ArrayView Point::GetLambda() const
 {
-    return lambda;
+    return ArrayView(GetArray(LAMBDA), GetSize(LAMBDA));
 }
 
-std::vector<double> const & Point::GetMu() const
+ArrayView Point::GetMu() const
 {
-    return mu;
+    return ArrayView(GetArray(MU), GetSize(MU));
 }
 
-std::vector<double> const & Point::GetConstraints() const
+ArrayView Point::GetConstraints() const
 {
-    return g;
+    return ArrayView(GetArray(G), GetSize(G));
 }
 
-std::vector<double> const & Point::GetPenalties() const
+ArrayView Point::GetPenalties() const
 {
-    return penalties;
+    return ArrayView(GetArray(PENALTIES), GetSize(PENALTIES));
 }
 
 double Point::GetDistance(double *const other_x) const
 {
+    double const *const x = GetArray(X);
+    size_t const num_variables = GetSize(X);
     double distance = 0;
-    for (int i = 0; i < x.size(); i += 1)
+    for (size_t i = 0; i < num_variables; i += 1)
     {
         distance += (x[i] - other_x[i]) * (x[i] - other_x[i]);
     }
@@ -137,6 +262,16 @@ double Point::GetDistance(double *const other_x) const
     return distance;
 }
 
+ArrayView Point::GetViolations() const
+{
+    return ArrayView(GetArray(VIOLATIONS), GetSize(VIOLATIONS));
+}
+
+double Point::GetMaxViolation() const
+{
+    return maxViolation;
+}
+
 double Point::GetMeritValue() const
 {
     return meritValue;
@@ -144,7 +279,7 @@ double Point::GetMeritValue() const
 
 bool Point::HasMultipliers() const
 {
-    return lambda.size() != 0;
+    return GetSize(LAMBDA) != 0;
 }
 
 bool Point::IsStopped() const
@@ -154,32 +289,33 @@ bool Point::IsStopped() const
 
 bool Point::IsFeasible() const
 {
-    for (double violation : cv)
-    {
-        if (violation > TOL_FEAS)
-        {
-            return false;
-        }
-    }
-    return true;
+    // compared here instead of being stored, since "TOL_FEAS" may change after construction
+    return maxViolation <= TOL_FEAS;
 }
 
 bool Point::IsSmaller(Point const &point, size_t const objective_index) const
 {
-    return f[objective_index] < point.f[objective_index];
+    return GetObjectiveValue(objective_index) < point.GetObjectiveValue(objective_index);
 }
 
 bool Point::IsDominated(Point const &point) const
 {
-    for (size_t i = 0; i < f.size(); i += 1)
+    return IsDominated(GetArray(F), maxViolation, point.GetArray(F), point.maxViolation, GetSize(F));
+}
+
+bool Point::IsDominated(double const *const f, double const max_violation,
+                        double const *const other_f, double const other_max_violation,
+                        size_t const num_objectives)
+{
+    for (size_t i = 0; i < num_objectives; i += 1)
     {
-        if (f[i] < point.f[i])
+        if (f[i] < other_f[i])
         {
             return false;
         }
     }
 
-    if (*std::max_element(cv.begin(), cv.end()) < *std::max_element(point.cv.begin(), point.cv.end()) - TOL_FEAS)
+    if (max_violation < other_max_violation - TOL_FEAS)
     {
         return false;
     }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "ArrayView.hpp"
 #include "../problem_formulation/MONLP.hpp"
 #include <cstddef>
 #include <vector>
@@ -13,23 +14,42 @@ class Point
 public:
     static double TOL_FEAS;
     static double TOL_DOMINATION;
+    // Whether points keep the violation of every bound and constraint or only the largest one.
+    // Only affects points constructed afterwards.
+    static bool KEEP_VIOLATIONS;
 
-    Point(std::vector<double> const &x, MONLP const &monlp);
-    Point(std::vector<double> const &x, std::vector<double> const &lambda, std::vector<double> const &mu,
-          std::vector<double> const &penalty, double merit_value, MONLP const &monlp);
+    // The arrays are copied straight into the memory block of the point, so they may as well
+    // view the buffers of a solver as vectors.
+    Point(ArrayView x, MONLP const &monlp);
+    Point(ArrayView x, ArrayView lambda, ArrayView mu, ArrayView penalty, double merit_value, MONLP const &monlp);
+    // Same as above but takes the objective-values "f" and constraint-values "g" at "x" instead of
+    // evaluating them again, e.g. those a solver computed in its last iteration.
+    Point(ArrayView x, ArrayView lambda, ArrayView mu, ArrayView penalty, ArrayView f, ArrayView g,
+          double merit_value, MONLP const &monlp);
     // Creates a random point within the given bounds.
     Point(std::vector<double> const &lower_bounds, std::vector<double> const &upper_bounds, MONLP const &monlp);
+    Point(Point const &other);
+    Point(Point &&other) noexcept;
+    Point & operator=(Point const &other);
+    Point & operator=(Point &&other) noexcept;
+    ~Point();
 
     // Marks this point as stopped.
     void SetStopped(bool stopped) const;
 
     double GetObjectiveValue(size_t objective_index) const;
-    std::vector<double> const & GetObjectiveValues() const;
-    std::vector<double> const & GetX() const;
-    std::vector<double> const & GetLambda() const;
-    std::vector<double> const & GetMu() const;
-    std::vector<double> const & GetConstraints() const;
-    std::vector<double> const & GetPenalties() const;
+    ArrayView GetObjectiveValues() const;
+    ArrayView GetX() const;
+    ArrayView GetLambda() const;
+    ArrayView GetMu() const;
+    ArrayView GetConstraints() const;
+    ArrayView GetPenalties() const;
+    // Violations of the lower and upper bound of each variable, followed by those of each
+    // constraint. Empty unless "KEEP_VIOLATIONS" was set when the point was constructed.
+    ArrayView GetViolations() const;
+    // Largest violation of any bound or constraint, zero if the point is feasible.
+    // Computed once when the function values are updated.
+    double GetMaxViolation() const;
     double GetMeritValue() const;
     double GetDistance(double *other_x) const;
     bool HasMultipliers() const;
@@ -38,18 +58,44 @@ public:
     bool IsDominated(Point const &point) const;
     bool IsSmaller(Point const &point, size_t objective_index) const;
 
+    // Whether a point with the objective-values "f" and the maximum violation "max_violation" is
+    // dominated by a point with "other_f" and "other_max_violation". Used by "IsDominated" and
+    // by the archives that don't store whole points.
+    static bool IsDominated(double const *f, double max_violation,
+                            double const *other_f, double other_max_violation, size_t num_objectives);
+
 private:
-    std::vector<double> x;
-    std::vector<double> lambda;
-    std::vector<double> mu;
-    std::vector<double> f;
-    std::vector<double> g;
-    std::vector<double> cv;
-    std::vector<double> penalties;
+    enum Array
+    {
+        X,
+        LAMBDA,
+        MU,
+        PENALTIES,
+        F,
+        G,
+        VIOLATIONS,
+        NUM_ARRAYS
+    };
+
+    // All arrays of the point in one block taken from the "BlockPool". The array "i" is stored
+    // in the range from "offsets[i]" to "offsets[i + 1]" of the block.
+    double *block;
+    size_t offsets[NUM_ARRAYS + 1];
+    double maxViolation;
     double meritValue;
     mutable bool stopped;
 
+    // Takes a block from the pool that fits arrays of the given sizes, in the order of "Array".
+    void Allocate(size_t const (&sizes)[NUM_ARRAYS]);
+    double * GetArray(Array array);
+    double const * GetArray(Array array) const;
+    size_t GetSize(Array array) const;
+    // Allocates the block for a point with the dimensions of the problem and the given sizes of
+    // the multipliers.
+    void Initialize(size_t num_lambda, size_t num_mu, size_t num_penalties, MONLP const &monlp);
     void UpdateFunctionValues(MONLP const &monlp);
+    // Computes the violations from "x" and "g".
+    void UpdateViolations(MONLP const &monlp);
 };
 
 } // namespace mosqp
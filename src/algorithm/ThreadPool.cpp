@@ -0,0 +1,230 @@
+#include "ThreadPool.hpp"
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+namespace mosqp
+{
+
+static size_t GetThreadCount(size_t const num_threads)
+{
+    return (num_threads == 0) ? std::max(1u, std::thread::hardware_concurrency()) : num_threads;
+}
+
+ThreadPool::ThreadPool(size_t const num_threads)
+    : queues(GetThreadCount(num_threads)), statistics(queues.size(), ThreadStatistics{ 0, 0, 0.0 }),
+      elapsedSeconds(0.0), numBatches(0), stopping(false), batch(0), numBusyWorkers(0), task(nullptr)
+{
+    workers.reserve(queues.size() - 1);
+    for (size_t thread_index = 1; thread_index < queues.size(); thread_index += 1)
+    {
+        workers.emplace_back(&ThreadPool::WorkerLoop, this, thread_index);
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    workAvailable.notify_all();
+    for (std::thread &worker : workers)
+    {
+        worker.join();
+    }
+}
+
+size_t ThreadPool::GetNumThreads() const
+{
+    return queues.size();
+}
+
+void ThreadPool::ParallelFor(size_t const num_tasks, std::function<void(size_t, size_t)> const &task)
+{
+    auto const start = std::chrono::steady_clock::now();
+#ifndef NDEBUG
+    // makes tasks that depend on what ran before them on the same thread show up, see the header
+    bool const reversed = (numBatches % 2 == 1);
+    size_t const rotation = numBatches;
+#else
+    bool const reversed = false;
+    size_t const rotation = 0;
+#endif
+    numBatches += 1;
+
+    if (workers.empty() || num_tasks <= 1)
+    {
+        this->task = &task;
+        for (size_t i = 0; i < num_tasks; i += 1)
+        {
+            RunTask(0, reversed ? num_tasks - 1 - i : i);
+        }
+        this->task = nullptr;
+    }
+    else
+    {
+        // contiguous ranges keep neighbouring tasks on one thread unless they get stolen
+        size_t const num_threads = queues.size();
+        for (size_t range_index = 0; range_index < num_threads; range_index += 1)
+        {
+            TaskQueue &queue = queues[(range_index + rotation) % num_threads];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            for (size_t task_index = range_index * num_tasks / num_threads;
+                 task_index < (range_index + 1) * num_tasks / num_threads; task_index += 1)
+            {
+                if (reversed)
+                {
+                    queue.tasks.push_front(task_index);
+                }
+                else
+                {
+                    queue.tasks.push_back(task_index);
+                }
+            }
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            this->task = &task;
+            numBusyWorkers = workers.size();
+            batch += 1;
+        }
+        workAvailable.notify_all();
+
+        RunTasks(0);
+
+        std::unique_lock<std::mutex> lock(mutex);
+        workDone.wait(lock, [this] { return numBusyWorkers == 0; });
+        this->task = nullptr;
+    }
+    elapsedSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::exception_ptr batch_error;
+    std::swap(batch_error, error);
+    if (batch_error)
+    {
+        std::rethrow_exception(batch_error);
+    }
+}
+
+std::vector<ThreadPool::ThreadStatistics> ThreadPool::GetStatistics() const
+{
+    return statistics;
+}
+
+double ThreadPool::GetElapsedSeconds() const
+{
+    return elapsedSeconds;
+}
+
+void ThreadPool::ResetStatistics()
+{
+    std::fill(statistics.begin(), statistics.end(), ThreadStatistics{ 0, 0, 0.0 });
+    elapsedSeconds = 0.0;
+}
+
+void ThreadPool::WorkerLoop(size_t const thread_index)
+{
+    size_t last_batch = 0;
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            workAvailable.wait(lock, [&] { return stopping || batch != last_batch; });
+            if (stopping)
+            {
+                return;
+            }
+            last_batch = batch;
+        }
+
+        RunTasks(thread_index);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            numBusyWorkers -= 1;
+        }
+        workDone.notify_one();
+    }
+}
+
+void ThreadPool::RunTasks(size_t const thread_index)
+{
+    // tasks never add new ones, so once no deque has a task left the batch is done for this thread
+    size_t task_index;
+    while (PopTask(thread_index, task_index))
+    {
+        RunTask(thread_index, task_index);
+    }
+
+    while (StealTask(thread_index, task_index))
+    {
+        statistics[thread_index].numStolenTasks += 1;
+        RunTask(thread_index, task_index);
+    }
+}
+
+bool ThreadPool::PopTask(size_t const thread_index, size_t &task_index)
+{
+    TaskQueue &queue = queues[thread_index];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty())
+    {
+        return false;
+    }
+
+    task_index = queue.tasks.front();
+    queue.tasks.pop_front();
+    return true;
+}
+
+bool ThreadPool::StealTask(size_t const thread_index, size_t &task_index)
+{
+    size_t const num_threads = queues.size();
+    for (size_t offset = 1; offset < num_threads; offset += 1)
+    {
+        TaskQueue &queue = queues[(thread_index + offset) % num_threads];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.tasks.empty())
+        {
+            task_index = queue.tasks.back();
+            queue.tasks.pop_back();
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void ThreadPool::RunTask(size_t const thread_index, size_t const task_index)
+{
+    auto const start = std::chrono::steady_clock::now();
+    try
+    {
+        (*task)(task_index, thread_index);
+    }
+    catch (...)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!error)
+        {
+            error = std::current_exception();
+        }
+    }
+
+    ThreadStatistics &thread_statistics = statistics[thread_index];
+    thread_statistics.numTasks += 1;
+    thread_statistics.busySeconds +=
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace mosqp
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+namespace mosqp
+{
+
+// A fixed set of threads that run batches of independent tasks. The thread calling
+// "ParallelFor" takes part in the work as thread 0, so a pool of one thread runs everything
+// serially without any synchronisation.
+// Every thread has a deque of tasks. A batch is split evenly over the deques, each thread works
+// through its own deque from the front, and a thread with an empty deque steals from the back of
+// the others. Tasks of very different lengths thus still keep all threads busy until the end.
+// Because of the stealing, which thread runs a task and which tasks ran on it before depend on
+// timing. So a task has to give the same result on any thread and after any other task: the
+// resources it takes by its thread index, like the solvers of "MOSQP", have to be put into a
+// fixed state by the task before it uses them. State that has to carry over from one task to
+// the next cannot live in such resources, it needs its own partition by task index instead.
+// Debug builds turn the order of every other batch around and move the tasks to other threads
+// from batch to batch, so that a task breaking this rule gives results that depend on the
+// number of threads, which "tests::CheckThreadIndependence" compares.
+class ThreadPool
+{
+public:
+    // How much work one thread did since the last "ResetStatistics()".
+    struct ThreadStatistics
+    {
+        size_t numTasks;
+        size_t numStolenTasks;
+        double busySeconds;
+    };
+
+    // Zero threads means one per hardware thread.
+    explicit ThreadPool(size_t num_threads);
+    ~ThreadPool();
+    ThreadPool(ThreadPool const &) = delete;
+    ThreadPool & operator=(ThreadPool const &) = delete;
+
+    size_t GetNumThreads() const;
+    // Calls "task(task_index, thread_index)" for every task index below "num_tasks", in no
+    // particular order, and returns once all of them are done. The thread index is below
+    // "GetNumThreads()" and lets a task use resources owned by the thread running it, see the
+    // class comment. An exception thrown by a task is rethrown here.
+    void ParallelFor(size_t num_tasks, std::function<void(size_t, size_t)> const &task);
+
+    std::vector<ThreadStatistics> GetStatistics() const;
+    // Time spent in "ParallelFor", the busy time of a thread divided by this is its utilisation.
+    double GetElapsedSeconds() const;
+    void ResetStatistics();
+
+private:
+    struct TaskQueue
+    {
+        std::mutex mutex;
+        std::deque<size_t> tasks;
+    };
+
+    std::vector<std::thread> workers;
+    // One per thread, including the calling one.
+    std::vector<TaskQueue> queues;
+    std::vector<ThreadStatistics> statistics;
+    double elapsedSeconds;
+    // Counts the calls of "ParallelFor", which debug builds use to vary the order of the tasks.
+    size_t numBatches;
+
+    std::mutex mutex;
+    std::condition_variable workAvailable;
+    std::condition_variable workDone;
+    bool stopping;
+    // Increased for every batch, so that the workers notice a new one.
+    size_t batch;
+    size_t numBusyWorkers;
+    std::function<void(size_t, size_t)> const *task;
+    std::exception_ptr error;
+
+    void WorkerLoop(size_t thread_index);
+    void RunTasks(size_t thread_index);
+    bool PopTask(size_t thread_index, size_t &task_index);
+    bool StealTask(size_t thread_index, size_t &task_index);
+    void RunTask(size_t thread_index, size_t task_index);
+};
+
+} // namespace mosqp
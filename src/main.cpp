@@ -15,6 +15,7 @@ int main()
     std::cout << "Constraint evaluations: " << test.GetNumEvalG() << std::endl;
     std::cout << "Jacobian evaluations: " << test.GetNumEvalDG() << std::endl;
     std::cout << "D2G evaluations: " << test.GetNumEvalD2G() << std::endl;
+    std::cout << "Cache hits: " << test.GetNumCacheHits() << ", misses: " << test.GetNumCacheMisses() << std::endl;
     
     system("pause");
     return 0;
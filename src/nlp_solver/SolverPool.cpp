@@ -0,0 +1,80 @@
+#include "SolverPool.hpp"
+#include "WorhpSolver.hpp"
+#include "../problem_formulation/MatrixStructure.hpp"
+#include "../problem_formulation/NLP.hpp"
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <typeindex>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+
+namespace mosqp
+{
+
+std::unique_ptr<WorhpSolver> SolverPool::Acquire(NLP const &nlp)
+{
+    Key const key = MakeKey(nlp);
+    std::unique_ptr<WorhpSolver> solver;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto const it = idleSolvers.find(key);
+        if (it != idleSolvers.end() && !it->second.empty())
+        {
+            solver = std::move(it->second.back());
+            it->second.pop_back();
+        }
+        else
+        {
+            numCreated += 1;
+        }
+    }
+
+    // setting up WORHP is the expensive part, so it happens outside of the lock
+    if (solver)
+    {
+        solver->SetProblem(nlp);
+        solver->ResetParameters();
+    }
+    else
+    {
+        solver = std::make_unique<WorhpSolver>(nlp);
+    }
+
+    return solver;
+}
+
+void SolverPool::Release(NLP const &nlp, std::unique_ptr<WorhpSolver> solver)
+{
+    Key key = MakeKey(nlp);
+    std::lock_guard<std::mutex> lock(mutex);
+    idleSolvers[std::move(key)].push_back(std::move(solver));
+}
+
+size_t SolverPool::GetNumCreated() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return numCreated;
+}
+
+SolverPool::Key SolverPool::MakeKey(NLP const &nlp)
+{
+    std::vector<size_t> signature = { nlp.GetVariant(), nlp.GetNumVariables(), nlp.GetNumConstraints(),
+                                      nlp.UserDF(), nlp.UserDG(), nlp.UserHM() };
+    AppendStructure(nlp.GetStructureDF(), signature);
+    AppendStructure(nlp.GetStructureDG(), signature);
+    AppendStructure(nlp.GetStructureHM(), signature);
+    return Key(std::type_index(typeid(nlp)), std::move(signature));
+}
+
+void SolverPool::AppendStructure(MatrixStructure const &structure, std::vector<size_t> &signature)
+{
+    signature.push_back(structure.IsDefined());
+    signature.push_back(structure.GetNumNonZeros());
+    signature.insert(signature.end(), structure.GetRowBegin(), structure.GetRowEnd());
+    signature.insert(signature.end(), structure.GetColBegin(), structure.GetColEnd());
+}
+
+} // namespace mosqp
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "WorhpSolver.hpp"
+#include "../problem_formulation/MatrixStructure.hpp"
+#include "../problem_formulation/NLP.hpp"
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <typeindex>
+#include <utility>
+#include <vector>
+
+
+namespace mosqp
+{
+
+// Keeps solvers that are not in use, so that they can be handed out again instead of setting up
+// WORHP from scratch. Solvers are only shared between problems of the same type with the same
+// dimensions and derivative structures, as WORHP sizes its workspace for them once, and that
+// minimise the same function, as it also scales the objective once.
+// Acquiring and releasing may happen from several threads at once.
+class SolverPool
+{
+public:
+    // Returns an idle solver set to "nlp", or a new one if there is none. The parameters are
+    // those right after initialising WORHP, so every user sets the ones it needs.
+    std::unique_ptr<WorhpSolver> Acquire(NLP const &nlp);
+    void Release(NLP const &nlp, std::unique_ptr<WorhpSolver> solver);
+    size_t GetNumCreated() const;
+
+private:
+    typedef std::pair<std::type_index, std::vector<size_t>> Key;
+
+    std::map<Key, std::vector<std::unique_ptr<WorhpSolver>>> idleSolvers;
+    size_t numCreated = 0;
+    mutable std::mutex mutex;
+
+    static Key MakeKey(NLP const &nlp);
+    static void AppendStructure(MatrixStructure const &structure, std::vector<size_t> &signature);
+};
+
+} // namespace mosqp
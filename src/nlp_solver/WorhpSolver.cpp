@@ -1,23 +1,31 @@
 #include "WorhpSolver.hpp"
 #include "worhp/worhp.h"
+#include "../algorithm/ArrayView.hpp"
 #include "../algorithm/Point.hpp"
 #include "../problem_formulation/MatrixStructure.hpp"
 #include "../problem_formulation/NLP.hpp"
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <cstddef>
+#include <iostream>
+#include <string>
 #include <vector>
 
 
 namespace mosqp
 {
 
+// relative to the working directory, "SetParameterFile" changes it when running from elsewhere
+std::string WorhpSolver::parameterFile = "../../../src/worhp.xml";
+std::atomic<bool> WorhpSolver::parameterFileRead(false);
+
 void silentPrint(int mode, const char *s)
 {
 }
 
 WorhpSolver::WorhpSolver(NLP const &nlp)
-    : nlp(nlp)
+    : nlp(&nlp)
 {
     //SetWorhpPrint(silentPrint);
     Init();
@@ -47,31 +55,60 @@ void WorhpSolver::Solve()
     }
 }
 
-void WorhpSolver::SetInitialGuess(std::vector<double> const &x)
+void WorhpSolver::SetInitialGuess(ArrayView const x)
 {
-    std::copy(x.begin(), x.end(), opt.X);
-    if (!(GetCurrentStage(&cnt) == Init_Data))
+    if (SetX(x))
     {
-        SetNextStage(&cnt, Pre_KKT);
-        cnt.status = Iterating;
+        // WORHP goes on from Pre_KKT, so it needs the values at the new guess
+        opt.F = wsp.ScaleObj * nlp->EvalFG(opt.X, opt.G);
+        if (retargeted)
+        {
+            ClearMultipliers();
+        }
     }
+    retargeted = false;
 }
 
 void WorhpSolver::SetInitialGuess(Point const &point)
 {
-    SetInitialGuess(point.GetX());
-    opt.F = nlp.GetF(point);
-    nlp.GetG(point, opt.G);
+    SetX(point.GetX());
+    opt.F = nlp->GetF(point);
+    nlp->GetG(point, opt.G);
     if (point.HasMultipliers())
     {
-        std::vector<double> const &lambda = point.GetLambda();
-        std::vector<double> const &mu = point.GetMu();
-        std::vector<double> const &penalties = point.GetPenalties();
+        ArrayView const lambda = point.GetLambda();
+        ArrayView const mu = point.GetMu();
+        ArrayView const penalties = point.GetPenalties();
         std::copy(lambda.cbegin(), lambda.cend(), opt.Lambda);
         std::copy(mu.cbegin(), mu.cend(), opt.Mu);
         std::copy(penalties.cbegin(), penalties.cend(), wsp.penalty);
         wsp.MeritOldValue = point.GetMeritValue();
     }
+    else if (retargeted)
+    {
+        ClearMultipliers();
+    }
+    retargeted = false;
+}
+
+bool WorhpSolver::SetX(ArrayView const x)
+{
+    std::copy(x.cbegin(), x.cend(), opt.X);
+    if (GetCurrentStage(&cnt) == Init_Data)
+    {
+        return false;
+    }
+
+    SetNextStage(&cnt, Pre_KKT);
+    cnt.status = Iterating;
+    return true;
+}
+
+void WorhpSolver::ClearMultipliers()
+{
+    std::fill(opt.Lambda, opt.Lambda + opt.n, 0.0);
+    std::fill(opt.Mu, opt.Mu + opt.m, 0.0);
+    std::fill(wsp.penalty, wsp.penalty + opt.m, 0.0);
 }
 
 bool WorhpSolver::Loop()
@@ -87,15 +124,23 @@ bool WorhpSolver::Loop()
         DoneUserAction(&cnt, iterOutput);
     }
 
+    // with "FGtogether" set both are requested at the same time
+    if (GetUserAction(&cnt, evalF) && GetUserAction(&cnt, evalG))
+    {
+        opt.F = wsp.ScaleObj * nlp->EvalFG(opt.X, opt.G);
+        DoneUserAction(&cnt, evalF);
+        DoneUserAction(&cnt, evalG);
+    }
+
     if (GetUserAction(&cnt, evalF))
     {
-        opt.F = wsp.ScaleObj * nlp.EvalF(opt.X);
+        opt.F = wsp.ScaleObj * nlp->EvalF(opt.X);
         DoneUserAction(&cnt, evalF);
     }
 
     if (GetUserAction(&cnt, evalDF))
     {
-        nlp.EvalDF(opt.X, wsp.DF.val);
+        nlp->EvalDF(opt.X, wsp.DF.val);
         for (size_t i = 0; i < wsp.DF.nnz; i += 1)
         {
             wsp.DF.val[i] *= wsp.ScaleObj;
@@ -105,19 +150,19 @@ bool WorhpSolver::Loop()
 
     if (GetUserAction(&cnt, evalG))
     {
-        nlp.EvalG(opt.X, opt.G);
+        nlp->EvalG(opt.X, opt.G);
         DoneUserAction(&cnt, evalG);
     }
 
     if (GetUserAction(&cnt, evalDG))
     {
-        nlp.EvalDG(opt.X, wsp.DG.val);
+        nlp->EvalDG(opt.X, wsp.DG.val);
         DoneUserAction(&cnt, evalDG);
     }
 
     if (GetUserAction(&cnt, evalHM))
     {
-        nlp.EvalHM(opt.X, opt.Mu, wsp.ScaleObj, wsp.HM.val);
+        nlp->EvalHM(opt.X, opt.Mu, wsp.ScaleObj, wsp.HM.val);
         DoneUserAction(&cnt, evalHM);
     }
 
@@ -129,40 +174,106 @@ bool WorhpSolver::Loop()
     return (cnt.status < TerminateSuccess && cnt.status > TerminateError);
 }
 
-void WorhpSolver::Init()
+void WorhpSolver::SetProblem(NLP const &nlp)
+{
+    assert(nlp.GetNumVariables() == this->nlp->GetNumVariables());
+    assert(nlp.GetNumConstraints() == this->nlp->GetNumConstraints());
+    this->nlp = &nlp;
+    retargeted = true;
+    CopyBounds();
+}
+
+void WorhpSolver::ResetParameters()
+{
+    par = initialParams;
+}
+
+void WorhpSolver::Restart()
+{
+    ResetParameters();
+    WorhpRestart(&opt, &wsp, &par, &cnt);
+    ClearMultipliers();
+    retargeted = false;
+}
+
+void WorhpSolver::CopyBounds()
+{
+    std::vector<double> const &xl = nlp->GetXL();
+    std::vector<double> const &xu = nlp->GetXU();
+    std::vector<double> const &gl = nlp->GetGL();
+    std::vector<double> const &gu = nlp->GetGU();
+    std::copy(xl.begin(), xl.end(), opt.XL);
+    std::copy(xu.begin(), xu.end(), opt.XU);
+    std::copy(gl.begin(), gl.end(), opt.GL);
+    std::copy(gu.begin(), gu.end(), opt.GU);
+}
+
+void WorhpSolver::SetParameterFile(std::string const &path)
+{
+    if (parameterFileRead)
+    {
+        std::cout << "WorhpSolver: The parameters were already read from '" << parameterFile
+                  << "', ignoring '" << path << "'!" << std::endl;
+        return;
+    }
+    parameterFile = path;
+}
+
+Params const & WorhpSolver::GetParameterTemplate()
+{
+    // initialising a static local is thread-safe, so the file is read exactly once
+    static Params const parameter_template = ReadParameterFile();
+    return parameter_template;
+}
+
+Params WorhpSolver::ReadParameterFile()
 {
+    parameterFileRead = true;
+    OptVar opt;
+    Workspace wsp;
+    Params par;
+    Control cnt;
     WorhpPreInit(&opt, &wsp, &par, &cnt);
 
     int status = 0;
-    char param_file[] = "../../../src/worhp.xml";
-    ReadParams(&status, param_file, &par);
+    std::vector<char> path(parameterFile.cbegin(), parameterFile.cend());
+    path.push_back('\0');
+    ReadParams(&status, path.data(), &par);
+    if (status == DataError || status == InitError)
+    {
+        std::cout << "WorhpSolver: Could not read the parameters from '" << parameterFile
+                  << "', using the defaults of WORHP!" << std::endl;
+        InitParams(&status, &par);
+    }
+
+    return par;
+}
+
+void WorhpSolver::Init()
+{
+    WorhpPreInit(&opt, &wsp, &par, &cnt);
+    par = GetParameterTemplate();
 
-    opt.n = static_cast<int>(nlp.GetNumVariables());
-    opt.m = static_cast<int>(nlp.GetNumConstraints());
+    opt.n = static_cast<int>(nlp->GetNumVariables());
+    opt.m = static_cast<int>(nlp->GetNumConstraints());
 
-    MatrixStructure const &structure_df = nlp.GetStructureDF();
-    MatrixStructure const &structure_dg = nlp.GetStructureDG();
-    MatrixStructure const &structure_hm = nlp.GetStructureHM();
+    MatrixStructure const &structure_df = nlp->GetStructureDF();
+    MatrixStructure const &structure_dg = nlp->GetStructureDG();
+    MatrixStructure const &structure_hm = nlp->GetStructureHM();
 
     wsp.DF.nnz = structure_df.IsDefined() ? static_cast<mat_int>(structure_df.GetNumNonZeros()) : WorhpMatrix_Init_Dense;
     wsp.DG.nnz = structure_dg.IsDefined() ? static_cast<mat_int>(structure_dg.GetNumNonZeros()) : WorhpMatrix_Init_Dense;
     wsp.HM.nnz = structure_hm.IsDefined() ? static_cast<mat_int>(structure_hm.GetNumNonZeros()) : WorhpMatrix_Init_Dense;
 
-    par.UserDF = nlp.UserDF();
-    par.UserDG = nlp.UserDG();
-    par.UserHM = nlp.UserHM();
+    par.UserDF = nlp->UserDF();
+    par.UserDG = nlp->UserDG();
+    par.UserHM = nlp->UserHM();
 
     WorhpInit(&opt, &wsp, &par, &cnt);
     assert(cnt.status == FirstCall);
 
-    std::vector<double> const &xl = nlp.GetXL();
-    std::vector<double> const &xu = nlp.GetXU();
-    std::vector<double> const &gl = nlp.GetGL();
-    std::vector<double> const &gu = nlp.GetGU();
-    std::copy(xl.begin(), xl.end(), opt.XL);
-    std::copy(xu.begin(), xu.end(), opt.XU);
-    std::copy(gl.begin(), gl.end(), opt.GL);
-    std::copy(gu.begin(), gu.end(), opt.GU);
+    initialParams = par;
+    CopyBounds();
 
     if (wsp.DF.NeedStructure)
     {
@@ -1,9 +1,11 @@
 #pragma once
 
 #include "worhp/worhp.h"
+#include "../algorithm/ArrayView.hpp"
 #include "../algorithm/Point.hpp"
 #include "../problem_formulation/NLP.hpp"
-#include <vector>
+#include <atomic>
+#include <string>
 
 
 namespace mosqp
@@ -22,12 +24,39 @@ public:
 
     void DoMajorIter();
     void Solve();
-    void SetInitialGuess(std::vector<double> const &x);
+    void SetInitialGuess(ArrayView x);
     void SetInitialGuess(Point const &point);
+    // Lets the solver work on another problem with the same dimensions and derivative structures,
+    // so that it can be reused without setting up WORHP again. The multipliers and penalties of
+    // the last problem are cleared with the next initial guess, unless it brings its own.
+    void SetProblem(NLP const &nlp);
+    // Restores the parameters the solver had right after its initialisation.
+    void ResetParameters();
+    // Puts the solver back into the state right after its initialisation: restores the
+    // parameters, clears the multipliers and penalties and lets WORHP start over from the next
+    // initial guess, so that its scaling, merit values and Hessian do not carry over from the
+    // last solve. Keeps the workspace, so this is much cheaper than setting up a new solver.
+    void Restart();
+    // Sets the WORHP parameter file, relative paths start at the working directory. The file is
+    // read once when the first solver is set up, so this has to be called before that. Later
+    // calls only print a warning.
+    static void SetParameterFile(std::string const &path);
 private:
-    NLP const &nlp;
+    static std::string parameterFile;
+    static std::atomic<bool> parameterFileRead;
+    NLP const *nlp;
+    Params initialParams;
+    // set by "SetProblem" until the next initial guess
+    bool retargeted = false;
     bool Loop();
     void Init();
+    // Copies the initial guess, returns whether WORHP restarts from it instead of initialising.
+    bool SetX(ArrayView x);
+    void ClearMultipliers();
+    void CopyBounds();
+    // The parameters read from "parameterFile", which every solver starts with.
+    static Params const & GetParameterTemplate();
+    static Params ReadParameterFile();
 };
 
 } // namespace mosqp
@@ -1,11 +1,11 @@
 #include "CombinedMONLP.hpp"
 #include "MatrixStructure.hpp"
 #include "MONLP.hpp"
+#include "../algorithm/ArrayView.hpp"
 #include <algorithm>
 #include <cassert>
 #include <cstddef>
 #include <limits>
-#include <numeric>
 #include <vector>
 
 
@@ -23,6 +23,7 @@ CombinedMONLP::CombinedMONLP(MONLP const &monlp, std::vector<double> const &scal
     combined_gu = monlp.GetGU();
     combined_gl.insert(combined_gl.end(), monlp.GetNumObjectives(), -std::numeric_limits<double>::infinity());
     combined_gu.insert(combined_gu.end(), monlp.GetNumObjectives(), 0);
+    ComputeEntryPositions();
 }
 
 void CombinedMONLP::SetParameters(std::vector<double> parameters)
@@ -32,7 +33,7 @@ void CombinedMONLP::SetParameters(std::vector<double> parameters)
 
 MatrixStructure CombinedMONLP::GetCombinedStructureDF(MONLP const &monlp)
 {
-    MatrixStructure combined_structure;
+    MatrixStructure::Builder builder;
     for (size_t objective_index = 0; objective_index < monlp.GetNumObjectives(); objective_index += 1)
     {
         MatrixStructure const &structure = monlp.GetStructureDF(objective_index);
@@ -41,13 +42,10 @@ MatrixStructure CombinedMONLP::GetCombinedStructureDF(MONLP const &monlp)
             return MatrixStructure(false);
         }
 
-        for (auto row = structure.GetRowBegin(); row != structure.GetRowEnd(); ++row)
-        {
-            combined_structure.SetEntryNNZ(*row, 1);
-        }
+        builder.AddEntries(structure);
     }
 
-    return combined_structure;
+    return builder.Build();
 }
 
 MatrixStructure CombinedMONLP::GetCombinedStructureDG(MONLP const &monlp)
@@ -57,7 +55,8 @@ MatrixStructure CombinedMONLP::GetCombinedStructureDG(MONLP const &monlp)
         return MatrixStructure(false);
     }
 
-    MatrixStructure combined_structure = monlp.GetStructureDG();
+    MatrixStructure::Builder builder;
+    builder.AddEntries(monlp.GetStructureDG());
     size_t const num_objectives = monlp.GetNumObjectives();
     size_t const num_constraints = monlp.GetNumConstraints();
     for (size_t objective_index = 0; objective_index < num_objectives; objective_index += 1)
@@ -67,25 +66,22 @@ MatrixStructure CombinedMONLP::GetCombinedStructureDG(MONLP const &monlp)
         {
             return MatrixStructure(false);
         }
-        
+
         for (auto row = df_structure.GetRowBegin(); row != df_structure.GetRowEnd(); ++row)
         {
-            combined_structure.SetEntryNNZ(num_constraints + objective_index + 1, *row);
+            builder.AddEntry(num_constraints + objective_index + 1, *row);
         }
     }
 
-    return combined_structure;
+    return builder.Build();
 }
 
 MatrixStructure CombinedMONLP::GetCombinedStructureHM(MONLP const &monlp)
 {
-    size_t const num_variables = monlp.GetNumVariables();
     size_t const num_objectives = monlp.GetNumObjectives();
 
-    std::vector<size_t> diag(num_variables);
-    std::iota(diag.begin(), diag.end(), 1);
-    MatrixStructure combined_structure(diag, diag);
-
+    // the whole diagonal comes last, the diagonal entries of the objectives are part of it
+    MatrixStructure::Builder builder(monlp.GetNumVariables());
     for (size_t objective_index = 0; objective_index < num_objectives; objective_index += 1)
     {
         MatrixStructure const &structure = monlp.GetStructureHM(objective_index);
@@ -94,21 +90,10 @@ MatrixStructure CombinedMONLP::GetCombinedStructureHM(MONLP const &monlp)
             return MatrixStructure(false);
         }
 
-        std::vector<size_t>::const_iterator row = structure.GetRowBegin();
-        std::vector<size_t>::const_iterator col = structure.GetColBegin();
-        while (row != structure.GetRowEnd() && col != structure.GetColEnd())
-        {
-            if (*row != *col)
-            {
-                combined_structure.SetEntryNNZ(*row, *col, num_variables);
-            }
-
-            ++row;
-            ++col;
-        }
+        builder.AddEntries(structure);
     }
 
-    return combined_structure;
+    return builder.Build();
 }
 
 std::vector<double> const & CombinedMONLP::GetGL() const
@@ -123,10 +108,11 @@ std::vector<double> const & CombinedMONLP::GetGU() const
 
 double CombinedMONLP::EvalF_impl(double const *const x) const
 {
+    std::vector<double> const &objective_values = EvalObjectives(x);
     double f = 0;
-    for (size_t i = 0; i < monlp.GetNumObjectives(); i += 1)
+    for (size_t i = 0; i < objective_values.size(); i += 1)
     {
-        f += monlp.EvalF(x, i) / scalings[i];
+        f += objective_values[i] / scalings[i];
     }
 
     return f;
@@ -146,18 +132,59 @@ double CombinedMONLP::GetF(Point const &point) const
 void CombinedMONLP::EvalG_impl(double const *const x, double *const g) const
 {
     monlp.EvalG(x, g);
+    Remember(lastG, x, g, monlp.GetNumConstraints());
+    SetObjectiveConstraints(EvalObjectives(x), g);
+}
 
+double CombinedMONLP::EvalFG_impl(double const *const x, double *const g) const
+{
     size_t const num_constraints = monlp.GetNumConstraints();
-    size_t const num_objectives = monlp.GetNumObjectives();
-    for (size_t i = 0; i < num_objectives; i += 1)
+    if (IsEvaluatedAt(lastF, x))
+    {
+        monlp.EvalG(x, g);
+    }
+    else
     {
-        g[i + num_constraints] = monlp.EvalF(x, i) - parameters[i];
+        lastF.x.assign(x, x + numVariables);
+        lastF.values.resize(monlp.GetNumObjectives());
+        monlp.EvalFG(x, lastF.values.data(), g);
+    }
+    Remember(lastG, x, g, num_constraints);
+    SetObjectiveConstraints(lastF.values, g);
+
+    double f = 0;
+    for (size_t i = 0; i < lastF.values.size(); i += 1)
+    {
+        f += lastF.values[i] / scalings[i];
+    }
+
+    return f;
+}
+
+std::vector<double> const & CombinedMONLP::EvalObjectives(double const *const x) const
+{
+    if (!IsEvaluatedAt(lastF, x))
+    {
+        lastF.x.assign(x, x + numVariables);
+        lastF.values.resize(monlp.GetNumObjectives());
+        monlp.EvalF(x, lastF.values.data());
+    }
+
+    return lastF.values;
+}
+
+void CombinedMONLP::SetObjectiveConstraints(std::vector<double> const &objective_values, double *const g) const
+{
+    size_t const num_constraints = monlp.GetNumConstraints();
+    for (size_t i = 0; i < objective_values.size(); i += 1)
+    {
+        g[i + num_constraints] = objective_values[i] - parameters[i];
     }
 }
 
 void CombinedMONLP::GetG(Point const &point, double *g) const
 {
-    std::vector<double> const &original_g = point.GetConstraints();
+    ArrayView const original_g = point.GetConstraints();
     std::copy(original_g.cbegin(), original_g.cend(), g);
 
     size_t const num_constraints = monlp.GetNumConstraints();
@@ -168,142 +195,159 @@ void CombinedMONLP::GetG(Point const &point, double *g) const
     }
 }
 
-void CombinedMONLP::EvalDF_impl(double const *const x, double *const df) const
+void CombinedMONLP::GetFunctionValues(double const *const x, double *const f, double *const g) const
 {
-    size_t const num_objectives = monlp.GetNumObjectives();
-    MatrixStructure structure_df = GetStructureDF();
-    std::vector<size_t>::const_iterator df_row = structure_df.GetRowBegin();
-    std::fill(df, df + structure_df.GetNumNonZeros(), 0.0);
-
-    size_t i;
-    for (size_t objective_index = 0; objective_index < num_objectives; objective_index += 1)
+    if (IsEvaluatedAt(lastF, x))
     {
-        i = 0;
-
-        MatrixStructure orig_structure_df = monlp.GetStructureDF(objective_index);
-        std::vector<double> df_orig_val_vector(orig_structure_df.GetNumNonZeros());
-        monlp.EvalDF(x, df_orig_val_vector.data(), objective_index);
+        std::copy(lastF.values.cbegin(), lastF.values.cend(), f);
+    }
+    else
+    {
+        monlp.EvalF(x, f);
+    }
 
-        std::vector<size_t>::const_iterator df_orig_row = orig_structure_df.GetRowBegin();
-        std::vector<size_t>::const_iterator df_orig_row_end = orig_structure_df.GetRowEnd();
-        std::vector<double>::const_iterator df_orig_val = df_orig_val_vector.cbegin();
+    if (IsEvaluatedAt(lastG, x))
+    {
+        std::copy(lastG.values.cbegin(), lastG.values.cend(), g);
+    }
+    else
+    {
+        monlp.EvalG(x, g);
+    }
+}
 
-        while (df_orig_row != df_orig_row_end)
+void CombinedMONLP::EvalDF_impl(double const *const x, double *const df) const
+{
+    std::fill(df, df + structureDF.GetNumNonZeros(), 0.0);
+    for (size_t objective_index = 0; objective_index < dfPositions.size(); objective_index += 1)
+    {
+        std::vector<size_t> const &positions = dfPositions[objective_index];
+        monlp.EvalDF(x, originalValues.data(), objective_index);
+        for (size_t i = 0; i < positions.size(); i += 1)
         {
-            if (*df_orig_row == df_row[i])
-            {
-                df[i] += *df_orig_val / scalings[objective_index];
-                ++df_orig_row;
-                ++df_orig_val;
-            }
-
-            i += 1;
+            df[positions[i]] += originalValues[i] / scalings[objective_index];
         }
     }
 }
 
 void CombinedMONLP::EvalDG_impl(double const *const x, double *const dg) const
 {
-    size_t const num_constraints = monlp.GetNumConstraints();
-    size_t const num_objectives = monlp.GetNumObjectives();
-    size_t const num_variables = monlp.GetNumVariables();
-    size_t dg_index = 0;
-
-    MatrixStructure const &structure_dg = monlp.GetStructureDG();
-    std::vector<double> dg_val(structure_dg.GetNumNonZeros());
-    monlp.EvalDG(x, dg_val.data());
-
-    for (size_t column = 1; column <= num_variables; column += 1)
+    // every entry of the combined Jacobian belongs to exactly one of the original derivatives
+    if (!dgPositions.empty())
     {
-        std::vector<size_t>::const_iterator dg_col = structure_dg.GetColBegin();
-        for (size_t i = 0; i < structure_dg.GetNumNonZeros(); i += 1)
+        monlp.EvalDG(x, originalValues.data());
+        for (size_t i = 0; i < dgPositions.size(); i += 1)
         {
-            if (dg_col[i] == column)
-            {
-                dg[dg_index] = dg_val[i];
-                dg_index += 1;
-            }
+            dg[dgPositions[i]] = originalValues[i];
         }
+    }
 
-        for (size_t objective_index = 0; objective_index < num_objectives; objective_index += 1)
+    for (size_t objective_index = 0; objective_index < dfDgPositions.size(); objective_index += 1)
+    {
+        std::vector<size_t> const &positions = dfDgPositions[objective_index];
+        monlp.EvalDF(x, originalValues.data(), objective_index);
+        for (size_t i = 0; i < positions.size(); i += 1)
         {
-            MatrixStructure const &structure_df = monlp.GetStructureDF(objective_index);
-            std::vector<double> df_val(structure_df.GetNumNonZeros());
-            monlp.EvalDF(x, df_val.data(), objective_index);
-
-            std::vector<size_t>::const_iterator df_row = structure_df.GetRowBegin();
-            for (size_t i = 0; i < structure_df.GetNumNonZeros(); i += 1)
-            {
-                if (df_row[i] == column)
-                {
-                    dg[dg_index] = df_val[i];
-                    dg_index += 1;
-                }
-            }
+            dg[positions[i]] = originalValues[i];
         }
     }
-
-    assert(dg_index == structureDG.GetNumNonZeros());
 }
 
 void CombinedMONLP::EvalHM_impl(double const *x, double const *mu, double scale_obj, double *hm) const
 {
-    size_t const num_objectives = monlp.GetNumObjectives();
     size_t const num_constraints = monlp.GetNumConstraints();
-    MatrixStructure structure_hm = GetStructureHM();
-    std::vector<size_t>::const_iterator hm_row = structure_hm.GetRowBegin();
-    std::vector<size_t>::const_iterator hm_col = structure_hm.GetColBegin();
-    std::fill(hm, hm + structure_hm.GetNumNonZeros(), 0.0);
-
-    size_t i;
-    for (size_t objective_index = 0; objective_index < num_objectives; objective_index += 1)
+    std::fill(hm, hm + structureHM.GetNumNonZeros(), 0.0);
+    for (size_t objective_index = 0; objective_index < d2fPositions.size(); objective_index += 1)
     {
-        i = 0;
+        std::vector<size_t> const &positions = d2fPositions[objective_index];
+        double const factor = 1.0 / scalings[objective_index] + mu[objective_index + num_constraints];
+        monlp.EvalD2F(x, originalValues.data(), objective_index);
+        for (size_t i = 0; i < positions.size(); i += 1)
+        {
+            hm[positions[i]] += originalValues[i] * factor;
+        }
+    }
 
-        MatrixStructure orig_structure_hm = monlp.GetStructureHM(objective_index);
-        std::vector<double> df2_orig_val_vector(orig_structure_hm.GetNumNonZeros());
-        monlp.EvalD2F(x, df2_orig_val_vector.data(), objective_index);
+    if (!d2gPositions.empty())
+    {
+        monlp.EvalD2G(x, mu, originalValues.data(), D2G_STRUCTURE_INDEX);
+        for (size_t i = 0; i < d2gPositions.size(); i += 1)
+        {
+            hm[d2gPositions[i]] += originalValues[i];
+        }
+    }
+}
 
-        std::vector<size_t>::const_iterator d2f_orig_row = orig_structure_hm.GetRowBegin();
-        std::vector<size_t>::const_iterator d2f_orig_col = orig_structure_hm.GetColBegin();
-        std::vector<double>::const_iterator d2f_orig_val = df2_orig_val_vector.cbegin();
-        std::vector<double>::const_iterator d2f_orig_val_end = df2_orig_val_vector.cend();
+void CombinedMONLP::ComputeEntryPositions()
+{
+    size_t const num_constraints = monlp.GetNumConstraints();
+    size_t const num_objectives = monlp.GetNumObjectives();
+    size_t max_nnz = 0;
 
-        while (d2f_orig_val != d2f_orig_val_end)
+    // undefined structures have no entries and are never assembled
+    if (structureDF.GetNumNonZeros() > 0)
+    {
+        dfPositions.resize(num_objectives);
+        for (size_t objective_index = 0; objective_index < num_objectives; objective_index += 1)
         {
-            if (*d2f_orig_row == hm_row[i] && *d2f_orig_col == hm_col[i])
-            {
-                hm[i] += *d2f_orig_val * (1.0 / scalings[objective_index] + mu[objective_index + num_constraints]);
-                ++d2f_orig_row;
-                ++d2f_orig_col;
-                ++d2f_orig_val;
-            }
-
-            i += 1;
+            MatrixStructure const &original = monlp.GetStructureDF(objective_index);
+            FindPositions(structureDF, original.GetRowBegin(), original.GetRowEnd(), original.GetColBegin(),
+                          dfPositions[objective_index]);
+            max_nnz = std::max(max_nnz, original.GetNumNonZeros());
         }
     }
 
-    MatrixStructure orig_structure_d2g = monlp.GetStructureHM(1);
-    std::vector<double> dg_val_vector(orig_structure_d2g.GetNumNonZeros());
-    monlp.EvalD2G(x, mu, dg_val_vector.data(), 1);
+    if (structureDG.GetNumNonZeros() > 0)
+    {
+        MatrixStructure const &original_dg = monlp.GetStructureDG();
+        FindPositions(structureDG, original_dg.GetRowBegin(), original_dg.GetRowEnd(), original_dg.GetColBegin(),
+                      dgPositions);
+        max_nnz = std::max(max_nnz, original_dg.GetNumNonZeros());
 
-    std::vector<size_t>::const_iterator d2g_orig_row = orig_structure_d2g.GetRowBegin();
-    std::vector<size_t>::const_iterator d2g_orig_col = orig_structure_d2g.GetColBegin();
-    std::vector<double>::const_iterator d2g_orig_val = dg_val_vector.cbegin();
-    std::vector<double>::const_iterator d2g_orig_val_end = dg_val_vector.cend();
+        // the gradient of objective "i" is the row "num_constraints + i + 1" of the combined Jacobian
+        dfDgPositions.resize(num_objectives);
+        for (size_t objective_index = 0; objective_index < num_objectives; objective_index += 1)
+        {
+            MatrixStructure const &original = monlp.GetStructureDF(objective_index);
+            std::vector<size_t> const rows(original.GetNumNonZeros(), num_constraints + objective_index + 1);
+            FindPositions(structureDG, rows.cbegin(), rows.cend(), original.GetRowBegin(),
+                          dfDgPositions[objective_index]);
+            max_nnz = std::max(max_nnz, original.GetNumNonZeros());
+        }
+    }
 
-    i = 0;
-    while (d2g_orig_val != d2g_orig_val_end)
+    if (structureHM.GetNumNonZeros() > 0)
     {
-        if (*d2g_orig_row == hm_row[i] && *d2g_orig_col == hm_col[i])
+        d2fPositions.resize(num_objectives);
+        for (size_t objective_index = 0; objective_index < num_objectives; objective_index += 1)
+        {
+            MatrixStructure const &original = monlp.GetStructureHM(objective_index);
+            FindPositions(structureHM, original.GetRowBegin(), original.GetRowEnd(), original.GetColBegin(),
+                          d2fPositions[objective_index]);
+            max_nnz = std::max(max_nnz, original.GetNumNonZeros());
+        }
+
+        if (num_constraints > 0)
         {
-            hm[i] += *d2g_orig_val;
-            ++d2g_orig_row;
-            ++d2g_orig_col;
-            ++d2g_orig_val;
+            MatrixStructure const &original = monlp.GetStructureHM(D2G_STRUCTURE_INDEX);
+            FindPositions(structureHM, original.GetRowBegin(), original.GetRowEnd(), original.GetColBegin(),
+                          d2gPositions);
         }
+    }
+
+    originalValues.resize(max_nnz);
+}
 
-        i += 1;
+void CombinedMONLP::FindPositions(MatrixStructure const &structure, std::vector<size_t>::const_iterator row,
+                                  std::vector<size_t>::const_iterator const row_end,
+                                  std::vector<size_t>::const_iterator col, std::vector<size_t> &entry_positions)
+{
+    entry_positions.clear();
+    for (; row != row_end; ++row, ++col)
+    {
+        size_t const position = structure.FindEntry(*row, *col);
+        assert(position != MatrixStructure::NO_ENTRY);
+        entry_positions.push_back(position);
     }
 }
 
@@ -4,6 +4,7 @@
 #include "NLP.hpp"
 #include "MONLP.hpp"
 #include "../algorithm/Point.hpp"
+#include <cstddef>
 #include <vector>
 
 
@@ -22,6 +23,7 @@ public:
 
     double GetF(Point const &point) const override;
     void GetG(Point const &point, double *g) const override;
+    void GetFunctionValues(double const *x, double *f, double *g) const override;
 
     void SetParameters(std::vector<double> parameters) override;
 
@@ -30,13 +32,43 @@ private:
     std::vector<double> combined_gl;
     std::vector<double> combined_gu;
     std::vector<double> scalings;
+    // The objective-values and the constraint-values of the original problem from the last
+    // evaluations. The objectives are needed by both "EvalF" and "EvalG", but are only evaluated
+    // once per "x" for both.
+    mutable LastEvaluation lastF;
+    mutable LastEvaluation lastG;
 
+    // Original problem whose Hessian structure describes that of "EvalD2G".
+    static size_t const D2G_STRUCTURE_INDEX = 1;
+
+    // Positions of the entries of the original derivatives in the combined ones. Computed once,
+    // so that assembling a combined derivative evaluates every original one once and scatters its
+    // values without searching. The gradients of the objectives appear in both DF and DG.
+    std::vector<std::vector<size_t>> dfPositions;
+    std::vector<size_t> dgPositions;
+    std::vector<std::vector<size_t>> dfDgPositions;
+    std::vector<std::vector<size_t>> d2fPositions;
+    std::vector<size_t> d2gPositions;
+    // Values of one original derivative, large enough for any of them. It is sized once by the
+    // constructor, and every thread that solves in parallel needs its own CombinedMONLP.
+    mutable std::vector<double> originalValues;
+
+    // Returns the values of all objectives at "x", evaluating them unless they are in "lastF".
+    std::vector<double> const & EvalObjectives(double const *x) const;
+    // Sets the constraints "f_i(x) - parameters[i]" at the end of "g".
+    void SetObjectiveConstraints(std::vector<double> const &objective_values, double *g) const;
+    void ComputeEntryPositions();
+    // Looks up the positions of the given entries, which must all be in the structure.
+    static void FindPositions(MatrixStructure const &structure, std::vector<size_t>::const_iterator row,
+                              std::vector<size_t>::const_iterator row_end, std::vector<size_t>::const_iterator col,
+                              std::vector<size_t> &entry_positions);
     static MatrixStructure GetCombinedStructureDF(MONLP const &monlp);
     static MatrixStructure GetCombinedStructureDG(MONLP const &monlp);
     static MatrixStructure GetCombinedStructureHM(MONLP const &monlp);
 
     double EvalF_impl(double const *x) const override;
     void EvalG_impl(double const *x, double *g) const override;
+    double EvalFG_impl(double const *x, double *g) const override;
     void EvalDF_impl(double const *x, double *df) const override;
     void EvalDG_impl(double const *x, double *dg) const override;
     void EvalHM_impl(double const *x, double const *mu, double scale_obj, double *hm) const override;
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "EvaluationCounter.hpp"
 #include "MatrixStructure.hpp"
 #include <cstddef>
 #include <vector>
@@ -43,8 +44,8 @@ protected:
     std::vector<double> const gl;
     std::vector<double> const gu;
 
-    mutable size_t numEvalG = 0;
-    mutable size_t numEvalDG = 0;
+    mutable EvaluationCounter numEvalG;
+    mutable EvaluationCounter numEvalDG;
 
     virtual void EvalG_impl(double const *x, double *g) const = 0;
     virtual void EvalDG_impl(double const *x, double *dg) const;
@@ -0,0 +1,143 @@
+#include "EvaluationCache.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+
+namespace mosqp
+{
+
+bool EvaluationCache::Key::operator==(Key const &other) const
+{
+    // compare bit patterns, so that e.g. 0.0 and -0.0 are different keys just like for the hash
+    return function == other.function && index == other.index && arguments.size() == other.arguments.size() &&
+           std::memcmp(arguments.data(), other.arguments.data(), arguments.size() * sizeof(double)) == 0;
+}
+
+size_t EvaluationCache::KeyHash::operator()(Key const &key) const
+{
+    // FNV-1a over the 64 bit words of the key
+    uint64_t hash = 14695981039346656037ull;
+    auto const add = [&hash](uint64_t const word)
+    {
+        hash ^= word;
+        hash *= 1099511628211ull;
+    };
+
+    add(static_cast<uint64_t>(key.function));
+    add(static_cast<uint64_t>(key.index));
+    for (double const argument : key.arguments)
+    {
+        uint64_t bits;
+        std::memcpy(&bits, &argument, sizeof(bits));
+        add(bits);
+    }
+    return static_cast<size_t>(hash);
+}
+
+EvaluationCache::EvaluationCache(size_t const max_entries)
+    : maxEntries(max_entries), numHits(0), numMisses(0)
+{
+}
+
+bool EvaluationCache::Lookup(EvaluatedFunction const function, size_t const index, double const *const x,
+                             size_t const num_x, double const *const mu, size_t const num_mu,
+                             double *const values, size_t const num_values, bool const count)
+{
+    Key const key = MakeKey(function, index, x, num_x, mu, num_mu);
+    std::lock_guard<std::mutex> lock(mutex);
+    auto const it = entryPositions.find(key);
+    if (it == entryPositions.end() || it->second->values.size() != num_values)
+    {
+        numMisses += count ? 1 : 0;
+        return false;
+    }
+
+    numHits += count ? 1 : 0;
+    entries.splice(entries.begin(), entries, it->second);
+    std::copy(it->second->values.cbegin(), it->second->values.cend(), values);
+    return true;
+}
+
+void EvaluationCache::CountLookup(bool const hit)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (hit)
+    {
+        numHits += 1;
+    }
+    else
+    {
+        numMisses += 1;
+    }
+}
+
+void EvaluationCache::Store(EvaluatedFunction const function, size_t const index, double const *const x,
+                            size_t const num_x, double const *const mu, size_t const num_mu,
+                            double const *const values, size_t const num_values)
+{
+    if (maxEntries == 0)
+    {
+        return;
+    }
+
+    Key key = MakeKey(function, index, x, num_x, mu, num_mu);
+    std::lock_guard<std::mutex> lock(mutex);
+    auto const inserted = entryPositions.emplace(std::move(key), entries.end());
+    if (!inserted.second)
+    {
+        // another thread stored it in the meantime
+        entries.splice(entries.begin(), entries, inserted.first->second);
+        return;
+    }
+
+    entries.push_front(Entry{ &inserted.first->first, std::vector<double>(values, values + num_values) });
+    inserted.first->second = entries.begin();
+    if (entries.size() > maxEntries)
+    {
+        entryPositions.erase(entryPositions.find(*entries.back().key));
+        entries.pop_back();
+    }
+}
+
+void EvaluationCache::Clear()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    entries.clear();
+    entryPositions.clear();
+}
+
+size_t EvaluationCache::GetNumHits() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return numHits;
+}
+
+size_t EvaluationCache::GetNumMisses() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return numMisses;
+}
+
+EvaluationCache::Key EvaluationCache::MakeKey(EvaluatedFunction const function, size_t const index,
+                                              double const *const x, size_t const num_x,
+                                              double const *const mu, size_t const num_mu)
+{
+    Key key{ function, index, std::vector<double>() };
+    key.arguments.reserve(num_x + num_mu);
+    key.arguments.insert(key.arguments.end(), x, x + num_x);
+    if (mu != nullptr)
+    {
+        key.arguments.insert(key.arguments.end(), mu, mu + num_mu);
+    }
+    return key;
+}
+
+} // namespace mosqp
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstddef>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+
+namespace mosqp
+{
+
+// Which function of a "MONLP" a cached value belongs to.
+enum class EvaluatedFunction
+{
+    F,
+    G,
+    DF,
+    DG,
+    D2F,
+    D2G
+};
+
+
+// Bounded cache of function values, keyed by the function, an index (e.g. of the objective) and
+// the exact bit pattern of the arguments, so only bitwise identical "x" (and "mu") hit. Once
+// "maxEntries" values are stored the least recently used one is dropped.
+// All member functions may be called from several threads at once. The functions are evaluated
+// outside of the lock, so two threads missing the same key at the same time both evaluate it.
+class EvaluationCache
+{
+public:
+    EvaluationCache(size_t max_entries);
+
+    // Copies the cached values into "values" if there are any for the given key. Counts a hit or
+    // a miss unless "count" is false, for callers that combine several lookups into one and count
+    // that with "CountLookup".
+    bool Lookup(EvaluatedFunction function, size_t index, double const *x, size_t num_x,
+                double const *mu, size_t num_mu, double *values, size_t num_values, bool count = true);
+    void CountLookup(bool hit);
+    void Store(EvaluatedFunction function, size_t index, double const *x, size_t num_x,
+               double const *mu, size_t num_mu, double const *values, size_t num_values);
+    void Clear();
+
+    size_t GetNumHits() const;
+    size_t GetNumMisses() const;
+
+private:
+    struct Key
+    {
+        EvaluatedFunction function;
+        size_t index;
+        // "x" followed by "mu".
+        std::vector<double> arguments;
+
+        bool operator==(Key const &other) const;
+    };
+
+    struct KeyHash
+    {
+        size_t operator()(Key const &key) const;
+    };
+
+    struct Entry
+    {
+        // Points to the key stored in "entryPositions", which does not move.
+        Key const *key;
+        std::vector<double> values;
+    };
+
+    size_t const maxEntries;
+    mutable std::mutex mutex;
+    // Most recently used entries first.
+    std::list<Entry> entries;
+    std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> entryPositions;
+    size_t numHits;
+    size_t numMisses;
+
+    static Key MakeKey(EvaluatedFunction function, size_t index, double const *x, size_t num_x,
+                       double const *mu, size_t num_mu);
+};
+
+} // namespace mosqp
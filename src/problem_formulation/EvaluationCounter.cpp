@@ -0,0 +1,37 @@
+#include "EvaluationCounter.hpp"
+#include <atomic>
+#include <cstddef>
+
+
+namespace mosqp
+{
+
+EvaluationCounter::EvaluationCounter()
+    : count(0)
+{
+}
+
+EvaluationCounter::EvaluationCounter(EvaluationCounter const &other)
+    : count(other.count.load(std::memory_order_relaxed))
+{
+}
+
+EvaluationCounter & EvaluationCounter::operator=(EvaluationCounter const &other)
+{
+    count.store(other.count.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    return *this;
+}
+
+EvaluationCounter & EvaluationCounter::operator+=(size_t const num_evaluations)
+{
+    // only the total is of interest, so no ordering with other memory is needed
+    count.fetch_add(num_evaluations, std::memory_order_relaxed);
+    return *this;
+}
+
+EvaluationCounter::operator size_t() const
+{
+    return count.load(std::memory_order_relaxed);
+}
+
+} // namespace mosqp
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+
+namespace mosqp
+{
+
+// Counts evaluations of a problem. The count may be increased from several threads at once,
+// unlike std::atomic the counter can be copied along with the problem it belongs to.
+class EvaluationCounter
+{
+public:
+    EvaluationCounter();
+    EvaluationCounter(EvaluationCounter const &other);
+    EvaluationCounter & operator=(EvaluationCounter const &other);
+
+    EvaluationCounter & operator+=(size_t num_evaluations);
+    operator size_t() const;
+
+private:
+    std::atomic<size_t> count;
+};
+
+} // namespace mosqp
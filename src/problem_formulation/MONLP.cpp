@@ -1,7 +1,9 @@
 #include "MONLP.hpp"
 #include "ConstrainedProblem.hpp"
+#include "EvaluationCache.hpp"
 #include "MatrixStructure.hpp"
 #include <cstddef>
+#include <memory>
 #include <vector>
 
 
@@ -50,33 +52,126 @@ void MONLP::EvalF(double const *const x, double *const f) const
 {
     for (size_t i = 0; i < numObjectives; i += 1)
     {
-        numEvalF += 1;
-        f[i] = EvalF_impl(x, i);
+        f[i] = EvalF(x, i);
     }
 }
 
 double MONLP::EvalF(double const *const x, size_t const objective_index) const
 {
+    double f;
+    if (LookupCache(EvaluatedFunction::F, objective_index, x, nullptr, &f, 1))
+    {
+        return f;
+    }
+
     numEvalF += 1;
-    return EvalF_impl(x, objective_index);
+    f = EvalF_impl(x, objective_index);
+    StoreCache(EvaluatedFunction::F, objective_index, x, nullptr, &f, 1);
+    return f;
+}
+
+void MONLP::EvalFG(double const *const x, double *const f, double *const g) const
+{
+    // only worth skipping the evaluation if everything is cached, so the probes count as a
+    // single lookup that only hits if all of them do
+    bool cached = (cache != nullptr);
+    for (size_t i = 0; i < numObjectives && cached; i += 1)
+    {
+        cached = LookupCache(EvaluatedFunction::F, i, x, nullptr, &f[i], 1, false);
+    }
+    if (cached && numConstraints > 0)
+    {
+        cached = LookupCache(EvaluatedFunction::G, 0, x, nullptr, g, numConstraints, false);
+    }
+    if (cache)
+    {
+        cache->CountLookup(cached);
+    }
+    if (cached)
+    {
+        return;
+    }
+
+    numEvalF += numObjectives;
+    numEvalG += 1;
+    EvalFG_impl(x, f, g);
+    for (size_t i = 0; i < numObjectives; i += 1)
+    {
+        StoreCache(EvaluatedFunction::F, i, x, nullptr, &f[i], 1);
+    }
+    StoreCache(EvaluatedFunction::G, 0, x, nullptr, g, numConstraints);
 }
 
 void MONLP::EvalDF(double const *const x, double *const df, size_t const objective_index) const
 {
+    size_t const num_values = GetNumCachedValues(structureDF[objective_index]);
+    if (LookupCache(EvaluatedFunction::DF, objective_index, x, nullptr, df, num_values))
+    {
+        return;
+    }
+
     numEvalDF += 1;
     EvalDF_impl(x, df, objective_index);
+    StoreCache(EvaluatedFunction::DF, objective_index, x, nullptr, df, num_values);
 }
 
 void MONLP::EvalD2F(double const *const x, double *const d2f, size_t const objective_index) const
 {
+    size_t const num_values = GetNumCachedValues(structureHM[objective_index]);
+    if (LookupCache(EvaluatedFunction::D2F, objective_index, x, nullptr, d2f, num_values))
+    {
+        return;
+    }
+
     numEvalD2F += 1;
     EvalD2F_impl(x, d2f, objective_index);
+    StoreCache(EvaluatedFunction::D2F, objective_index, x, nullptr, d2f, num_values);
 }
 
 void MONLP::EvalD2G(double const *const x, double const *mu, double *const d2g, size_t const objective_index) const
 {
+    size_t const num_values = GetNumCachedValues(structureHM[objective_index]);
+    if (LookupCache(EvaluatedFunction::D2G, objective_index, x, mu, d2g, num_values))
+    {
+        return;
+    }
+
     numEvalD2G += 1;
     EvalD2G_impl(x, mu, d2g, objective_index);
+    StoreCache(EvaluatedFunction::D2G, objective_index, x, mu, d2g, num_values);
+}
+
+void MONLP::EvalG(double const *const x, double *const g) const
+{
+    if (LookupCache(EvaluatedFunction::G, 0, x, nullptr, g, numConstraints))
+    {
+        return;
+    }
+
+    ConstrainedProblem::EvalG(x, g);
+    StoreCache(EvaluatedFunction::G, 0, x, nullptr, g, numConstraints);
+}
+
+void MONLP::EvalDG(double const *const x, double *const dg) const
+{
+    size_t const num_values = GetNumCachedValues(structureDG);
+    if (LookupCache(EvaluatedFunction::DG, 0, x, nullptr, dg, num_values))
+    {
+        return;
+    }
+
+    ConstrainedProblem::EvalDG(x, dg);
+    StoreCache(EvaluatedFunction::DG, 0, x, nullptr, dg, num_values);
+}
+
+void MONLP::EnableCache(size_t const max_entries)
+{
+    cache = std::make_shared<EvaluationCache>(max_entries);
+}
+
+void MONLP::DisableCache()
+{
+    cache.reset();
 }
 
 size_t MONLP::GetNumEvalF() const
@@ -99,6 +194,55 @@ size_t MONLP::GetNumEvalD2G() const
     return numEvalD2G;
 }
 
+size_t MONLP::GetNumCacheHits() const
+{
+    return cache ? cache->GetNumHits() : 0;
+}
+
+size_t MONLP::GetNumCacheMisses() const
+{
+    return cache ? cache->GetNumMisses() : 0;
+}
+
+size_t MONLP::GetNumCachedValues(MatrixStructure const &structure)
+{
+    return structure.IsDefined() ? structure.GetNumNonZeros() : 0;
+}
+
+bool MONLP::LookupCache(EvaluatedFunction const function, size_t const index, double const *const x,
+                        double const *const mu, double *const values, size_t const num_values,
+                        bool const count) const
+{
+    if (!cache || num_values == 0)
+    {
+        return false;
+    }
+
+    size_t const num_mu = (mu != nullptr) ? numConstraints : 0;
+    return cache->Lookup(function, index, x, numVariables, mu, num_mu, values, num_values, count);
+}
+
+void MONLP::StoreCache(EvaluatedFunction const function, size_t const index, double const *const x,
+                       double const *const mu, double const *const values, size_t const num_values) const
+{
+    if (!cache || num_values == 0)
+    {
+        return;
+    }
+
+    size_t const num_mu = (mu != nullptr) ? numConstraints : 0;
+    cache->Store(function, index, x, numVariables, mu, num_mu, values, num_values);
+}
+
+void MONLP::EvalFG_impl(double const *const x, double *const f, double *const g) const
+{
+    for (size_t i = 0; i < numObjectives; i += 1)
+    {
+        f[i] = EvalF_impl(x, i);
+    }
+    EvalG_impl(x, g);
+}
+
 void MONLP::EvalDF_impl(double const *const x, double *const df, size_t const objective_index) const
 {
 }
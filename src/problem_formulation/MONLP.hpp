@@ -1,8 +1,11 @@
 #pragma once
 
 #include "ConstrainedProblem.hpp"
+#include "EvaluationCache.hpp"
+#include "EvaluationCounter.hpp"
 #include "MatrixStructure.hpp"
 #include <cstddef>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -24,14 +27,29 @@ public:
 
     void EvalF(double const *x, double *f) const;
     double EvalF(double const *x, size_t objective_index) const;
+    // Evaluates all objectives and the constraints at once.
+    void EvalFG(double const *x, double *f, double *g) const;
     void EvalDF(double const *x, double *df, size_t objective_index) const;
     void EvalD2F(double const *x, double *d2f, size_t objective_index) const;
     void EvalD2G(double const *x, double const *mu, double *d2g, size_t objective_index) const;
+    // Same as in "ConstrainedProblem" but going through the cache.
+    void EvalG(double const *x, double *g) const;
+    void EvalDG(double const *x, double *dg) const;
+
+    // Keeps up to "max_entries" function values and derivatives, so that evaluating again at
+    // exactly the same point is only a lookup. Off by default, as it only pays off for functions
+    // that are expensive compared to copying their values. Derivatives without a defined
+    // structure are never cached.
+    void EnableCache(size_t max_entries);
+    void DisableCache();
 
     size_t GetNumEvalF() const;
     size_t GetNumEvalDF() const;
     size_t GetNumEvalD2F() const;
     size_t GetNumEvalD2G() const;
+    // Lookups answered from the cache and those that had to evaluate, zero without a cache.
+    size_t GetNumCacheHits() const;
+    size_t GetNumCacheMisses() const;
 
     virtual std::string GetName() const = 0;
 
@@ -50,15 +68,29 @@ protected:
     bool const userDF;
     bool const userHM;
 
-    mutable size_t numEvalF = 0;
-    mutable size_t numEvalDF = 0;
-    mutable size_t numEvalD2F = 0;
-    mutable size_t numEvalD2G = 0;
+    mutable EvaluationCounter numEvalF;
+    mutable EvaluationCounter numEvalDF;
+    mutable EvaluationCounter numEvalD2F;
+    mutable EvaluationCounter numEvalD2G;
+
+    std::shared_ptr<EvaluationCache> cache;
 
     virtual double EvalF_impl(double const *x, size_t objective_index) const = 0;
+    // Evaluates the objectives and constraints one by one, problems that compute them together
+    // can override this.
+    virtual void EvalFG_impl(double const *x, double *f, double *g) const;
     virtual void EvalDF_impl(double const *x, double *df, size_t objective_index) const;
     virtual void EvalD2F_impl(double const *x, double *d2f, size_t objective_index) const;
     virtual void EvalD2G_impl(double const *x, double const *mu, double *d2g, size_t objective_index) const;
+
+private:
+    // Number of values of a derivative with the given structure, zero if it is not defined.
+    static size_t GetNumCachedValues(MatrixStructure const &structure);
+    // Both do nothing without a cache or values. "count" as in "EvaluationCache::Lookup".
+    bool LookupCache(EvaluatedFunction function, size_t index, double const *x, double const *mu,
+                     double *values, size_t num_values, bool count = true) const;
+    void StoreCache(EvaluatedFunction function, size_t index, double const *x, double const *mu,
+                    double const *values, size_t num_values) const;
 };
 
 } // namespace mosqp
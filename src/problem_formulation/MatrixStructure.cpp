@@ -1,28 +1,88 @@
 #include "MatrixStructure.hpp"
+#include <algorithm>
 #include <cassert>
 #include <cstddef>
+#include <numeric>
+#include <utility>
 #include <vector>
 
 
 namespace mosqp
 {
 
+MatrixStructure::Builder::Builder(size_t const num_special_diag)
+    : numSpecialDiag(num_special_diag)
+{
+}
+
+void MatrixStructure::Builder::AddEntry(size_t const row, size_t const col)
+{
+    if (row != col || col > numSpecialDiag)
+    {
+        entries.emplace_back(col, row);
+    }
+}
+
+void MatrixStructure::Builder::AddEntries(MatrixStructure const &structure)
+{
+    for (size_t i = 0; i < structure.GetNumNonZeros(); i += 1)
+    {
+        AddEntry(structure.row[i], structure.col[i]);
+    }
+}
+
+MatrixStructure MatrixStructure::Builder::Build() const
+{
+    // the entries are stored as (column, row), so sorting them gives the column-wise order
+    std::vector<std::pair<size_t, size_t>> sorted_entries(entries);
+    std::sort(sorted_entries.begin(), sorted_entries.end());
+    sorted_entries.erase(std::unique(sorted_entries.begin(), sorted_entries.end()), sorted_entries.end());
+
+    size_t const num_sorted = sorted_entries.size();
+    size_t const num_columns = sorted_entries.empty() ? 0 : sorted_entries.back().first;
+    std::vector<size_t> row(num_sorted + numSpecialDiag);
+    std::vector<size_t> col(num_sorted + numSpecialDiag);
+    std::vector<size_t> col_pointers(num_columns + 1, 0);
+    for (size_t i = 0; i < num_sorted; i += 1)
+    {
+        col[i] = sorted_entries[i].first;
+        row[i] = sorted_entries[i].second;
+        col_pointers[col[i]] += 1;
+    }
+    std::partial_sum(col_pointers.begin(), col_pointers.end(), col_pointers.begin());
+
+    for (size_t i = 0; i < numSpecialDiag; i += 1)
+    {
+        row[num_sorted + i] = i + 1;
+        col[num_sorted + i] = i + 1;
+    }
+
+    return MatrixStructure(std::move(row), std::move(col), std::move(col_pointers), numSpecialDiag);
+}
+
 MatrixStructure::MatrixStructure(bool const defined)
-    : defined(defined),  nnz(0), row(), col()
+    : defined(defined),  nnz(0), row(), col(), colPointers(defined ? 1 : 0, 0), numSpecialDiag(0)
 {
 }
 
 MatrixStructure::MatrixStructure(std::vector<size_t> const & row)
-    : defined(true), nnz(row.size()), row(row), col(nnz, 1)
+    : defined(true), nnz(row.size()), row(row), col(nnz, 1), numSpecialDiag(0)
 {
 }
 
 MatrixStructure::MatrixStructure(std::vector<size_t> const & row, std::vector<size_t> const & col)
-    : defined(true), nnz(row.size()), row(row), col(col)
+    : defined(true), nnz(row.size()), row(row), col(col), numSpecialDiag(0)
 {
     assert(row.size() == col.size());
 }
 
+MatrixStructure::MatrixStructure(std::vector<size_t> row, std::vector<size_t> col,
+                                 std::vector<size_t> col_pointers, size_t const num_special_diag)
+    : defined(true), nnz(row.size()), row(std::move(row)), col(std::move(col)),
+      colPointers(std::move(col_pointers)), numSpecialDiag(num_special_diag)
+{
+}
+
 void MatrixStructure::SetEntryNNZ(size_t const new_row, size_t const new_col, size_t const num_special_diag)
 {
     size_t index = 0;
@@ -41,6 +101,19 @@ void MatrixStructure::SetEntryNNZ(size_t const new_row, size_t const new_col, si
         row.insert(row.begin() + index, new_row);
         col.insert(col.begin() + index, new_col);
         nnz += 1;
+
+        if (HasColPointers())
+        {
+            // all columns from the new one on start one entry later
+            if (colPointers.size() <= new_col)
+            {
+                colPointers.resize(new_col + 1, colPointers.back());
+            }
+            for (size_t j = new_col; j < colPointers.size(); j += 1)
+            {
+                colPointers[j] += 1;
+            }
+        }
     }
 
     assert(row.size() == nnz);
@@ -78,6 +151,40 @@ std::vector<size_t>::const_iterator MatrixStructure::GetColEnd() const
     return col.cend();
 }
 
+bool MatrixStructure::HasColPointers() const
+{
+    return !colPointers.empty();
+}
+
+std::vector<size_t>::const_iterator MatrixStructure::GetColPointerBegin() const
+{
+    return colPointers.cbegin();
+}
+
+std::vector<size_t>::const_iterator MatrixStructure::GetColPointerEnd() const
+{
+    return colPointers.cend();
+}
+
+size_t MatrixStructure::FindEntry(size_t const row, size_t const col) const
+{
+    assert(HasColPointers());
+    if (row == col && col <= numSpecialDiag)
+    {
+        return nnz - numSpecialDiag + col - 1;
+    }
+
+    if (col == 0 || col >= colPointers.size())
+    {
+        return NO_ENTRY;
+    }
+
+    auto const begin = this->row.cbegin() + colPointers[col - 1];
+    auto const end = this->row.cbegin() + colPointers[col];
+    auto const it = std::lower_bound(begin, end, row);
+    return (it != end && *it == row) ? static_cast<size_t>(it - this->row.cbegin()) : NO_ENTRY;
+}
+
 bool MatrixStructure::IsSortingCorrect(size_t num_special_diag)
 {
     for (size_t i = 0; i < nnz - num_special_diag - 1; i += 1)
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstddef>
+#include <utility>
 #include <vector>
 
 
@@ -10,6 +11,29 @@ namespace mosqp
 class MatrixStructure
 {
 public:
+    static size_t const NO_ENTRY = static_cast<size_t>(-1);
+
+    // Collects entries in any order and builds the structure in one go, sorted by column first and
+    // row second (compressed sparse column) with duplicates removed. Takes O(nnz log nnz), whereas
+    // building the same structure with "SetEntryNNZ" takes O(nnz^2).
+    class Builder
+    {
+    public:
+        // With "num_special_diag" > 0 the structure ends with all diagonal entries of the first
+        // "num_special_diag" columns in order, as WORHP expects for Hessians. Diagonal entries
+        // added to such a builder are left out of the sorted part.
+        Builder(size_t num_special_diag = 0);
+
+        // Rows and columns start at 1.
+        void AddEntry(size_t row, size_t col);
+        void AddEntries(MatrixStructure const &structure);
+        MatrixStructure Build() const;
+
+    private:
+        size_t numSpecialDiag;
+        std::vector<std::pair<size_t, size_t>> entries;
+    };
+
     MatrixStructure(bool defined = true);
     MatrixStructure(std::vector<size_t> const &row);
     MatrixStructure(std::vector<size_t> const &row, std::vector<size_t> const &col);
@@ -22,11 +46,27 @@ public:
     std::vector<size_t>::const_iterator GetRowEnd() const;
     std::vector<size_t>::const_iterator GetColBegin() const;
     std::vector<size_t>::const_iterator GetColEnd() const;
+    // Whether the column pointers below are available. Structures given by their rows and columns
+    // don't have them, as their entries need not be sorted.
+    bool HasColPointers() const;
+    // Entry "j" points to the first entry of the column "j + 1" and the last one to the end of the
+    // sorted part, so column "j + 1" spans from "colPointers[j]" to "colPointers[j + 1]".
+    std::vector<size_t>::const_iterator GetColPointerBegin() const;
+    std::vector<size_t>::const_iterator GetColPointerEnd() const;
+    // Position of the given entry or "NO_ENTRY", takes O(log nnz). Needs the column pointers.
+    size_t FindEntry(size_t row, size_t col) const;
+
 private:
     bool const defined;
     size_t nnz;
     std::vector<size_t> row;
     std::vector<size_t> col;
+    std::vector<size_t> colPointers;
+    // Number of diagonal entries at the end, only known for structures from a "Builder".
+    size_t numSpecialDiag;
+
+    MatrixStructure(std::vector<size_t> row, std::vector<size_t> col, std::vector<size_t> col_pointers,
+                    size_t num_special_diag);
 
     bool IsSortingCorrect(size_t num_special_diag = 0);
 };
@@ -1,6 +1,7 @@
 #include "NLP.hpp"
 #include "ConstrainedProblem.hpp"
 #include "MatrixStructure.hpp"
+#include <algorithm>
 #include <cstddef>
 #include <vector>
 
@@ -46,6 +47,13 @@ double NLP::EvalF(double const *const x) const
     return EvalF_impl(x);
 }
 
+double NLP::EvalFG(double const *const x, double *const g) const
+{
+    numEvalF += 1;
+    numEvalG += 1;
+    return EvalFG_impl(x, g);
+}
+
 void NLP::EvalDF(double const *const x, double *const df) const
 {
     numEvalDF += 1;
@@ -63,6 +71,30 @@ void NLP::SetParameters(std::vector<double> parameters)
     this->parameters = parameters;
 }
 
+size_t NLP::GetVariant() const
+{
+    return 0;
+}
+
+bool NLP::IsEvaluatedAt(LastEvaluation const &evaluation, double const *const x) const
+{
+    return evaluation.x.size() == numVariables && std::equal(evaluation.x.cbegin(), evaluation.x.cend(), x);
+}
+
+void NLP::Remember(LastEvaluation &evaluation, double const *const x, double const *const values,
+                   size_t const num_values) const
+{
+    evaluation.x.assign(x, x + numVariables);
+    evaluation.values.assign(values, values + num_values);
+}
+
+double NLP::EvalFG_impl(double const *const x, double *const g) const
+{
+    double const f = EvalF_impl(x);
+    EvalG_impl(x, g);
+    return f;
+}
+
 void NLP::EvalDF_impl(double const *const x, double *const df) const
 {
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "ConstrainedProblem.hpp"
+#include "EvaluationCounter.hpp"
 #include "MatrixStructure.hpp"
 #include "../algorithm/Point.hpp"
 #include <cstddef>
@@ -19,12 +20,22 @@ public:
     bool UserHM() const;
 
     double EvalF(double const *x) const;
+    // Evaluates the objective and the constraints at once and returns the objective. Problems
+    // that share work between the two can do it only once this way.
+    double EvalFG(double const *x, double *g) const;
     virtual double GetF(Point const &point) const = 0;
     virtual void GetG(Point const &point, double *g) const = 0;
+    // The other way around, writes the objective-values "f" and the constraint-values "g" of the
+    // underlying multiobjective problem at "x". Values the last evaluations computed at the same
+    // "x" are reused, so right after a solver step this usually needs no evaluation at all.
+    virtual void GetFunctionValues(double const *x, double *f, double *g) const = 0;
     void EvalDF(double const *x, double *df) const;
     void EvalHM(double const *x, double const *mu, double scale_obj, double *hm) const;
 
     virtual void SetParameters(std::vector<double> parameters);
+    // Problems of the same type that minimise different functions return different variants.
+    // WORHP scales the objective once, so a solver is only reused for the same variant.
+    virtual size_t GetVariant() const;
 
 protected:
     NLP(size_t num_variables, size_t num_constraints,
@@ -39,12 +50,23 @@ protected:
 
     std::vector<double> parameters;
 
+    // Values of the multiobjective problem that an evaluation computed, together with the "x"
+    // they belong to.
+    struct LastEvaluation
+    {
+        std::vector<double> x;
+        std::vector<double> values;
+    };
+    bool IsEvaluatedAt(LastEvaluation const &evaluation, double const *x) const;
+    void Remember(LastEvaluation &evaluation, double const *x, double const *values, size_t num_values) const;
+
     // bookkeeping variables
-    mutable size_t numEvalF = 0;
-    mutable size_t numEvalDF = 0;
-    mutable size_t numEvalHM = 0;
+    mutable EvaluationCounter numEvalF;
+    mutable EvaluationCounter numEvalDF;
+    mutable EvaluationCounter numEvalHM;
 
     virtual double EvalF_impl(double const *x) const = 0;
+    virtual double EvalFG_impl(double const *x, double *g) const;
     virtual void EvalDF_impl(double const *x, double *df) const;
     virtual void EvalHM_impl(double const *x, double const *mu, double scale_obj, double *hm) const;
 };
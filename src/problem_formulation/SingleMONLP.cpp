@@ -1,6 +1,9 @@
 #include "SingleMONLP.hpp"
 #include "MONLP.hpp"
+#include "../algorithm/ArrayView.hpp"
+#include <algorithm>
 #include <cstddef>
+#include <vector>
 
 
 namespace mosqp
@@ -14,13 +17,16 @@ SingleMONLP::SingleMONLP(MONLP const &monlp, size_t const objective_index)
           monlp.UserDF(), monlp.UserDG(), monlp.UserHM(),
           monlp.GetXL(), monlp.GetXU(),
           monlp.GetGL(), monlp.GetGU()),
-    monlp(monlp), objectiveIndex(objective_index)
+    monlp(monlp), objectiveIndex(objective_index),
+    d2gValues(monlp.GetStructureHM(objective_index).GetNumNonZeros())
 {
 }
 
 double SingleMONLP::EvalF_impl(double const *const x) const
 {
-    return monlp.EvalF(x, objectiveIndex);
+    double const f = monlp.EvalF(x, objectiveIndex);
+    Remember(lastF, x, &f, 1);
+    return f;
 }
 
 double SingleMONLP::GetF(Point const &point) const
@@ -28,17 +34,49 @@ double SingleMONLP::GetF(Point const &point) const
     return point.GetObjectiveValue(objectiveIndex);
 }
 
+size_t SingleMONLP::GetVariant() const
+{
+    return objectiveIndex;
+}
+
 void SingleMONLP::EvalG_impl(double const *const x, double *const g) const
 {
     monlp.EvalG(x, g);
+    Remember(lastG, x, g, numConstraints);
 }
 
 void SingleMONLP::GetG(Point const &point, double *g) const
 {
-    std::vector<double> const &original_g = point.GetConstraints();
+    ArrayView const original_g = point.GetConstraints();
     std::copy(original_g.cbegin(), original_g.cend(), g);
 }
 
+void SingleMONLP::GetFunctionValues(double const *const x, double *const f, double *const g) const
+{
+    // the other objectives are never evaluated by the solver
+    size_t const num_objectives = monlp.GetNumObjectives();
+    for (size_t i = 0; i < num_objectives; i += 1)
+    {
+        if (i == objectiveIndex && IsEvaluatedAt(lastF, x))
+        {
+            f[i] = lastF.values[0];
+        }
+        else
+        {
+            f[i] = monlp.EvalF(x, i);
+        }
+    }
+
+    if (IsEvaluatedAt(lastG, x))
+    {
+        std::copy(lastG.values.cbegin(), lastG.values.cend(), g);
+    }
+    else
+    {
+        monlp.EvalG(x, g);
+    }
+}
+
 void SingleMONLP::EvalDF_impl(double const *const x, double *const df) const
 {
     return monlp.EvalDF(x, df, objectiveIndex);
@@ -51,15 +89,14 @@ void SingleMONLP::EvalDG_impl(double const *const x, double *const dg) const
 
 void SingleMONLP::EvalHM_impl(double const *const x, double const *mu, double const scale_obj, double *const hm) const
 {
-    size_t const hm_nnz = monlp.GetStructureHM(objectiveIndex).GetNumNonZeros();
-    std::vector<double> d2g(hm_nnz, 0.0);
-
+    size_t const hm_nnz = d2gValues.size();
+    std::fill(d2gValues.begin(), d2gValues.end(), 0.0);
     monlp.EvalD2F(x, hm, objectiveIndex);
-    monlp.EvalD2G(x, mu, d2g.data(), objectiveIndex);
+    monlp.EvalD2G(x, mu, d2gValues.data(), objectiveIndex);
 
     for (size_t i = 0; i < hm_nnz; i += 1)
     {
-        hm[i] = scale_obj * hm[i] + d2g[i];
+        hm[i] = scale_obj * hm[i] + d2gValues[i];
     }
 }
 
@@ -3,6 +3,7 @@
 #include "NLP.hpp"
 #include "MONLP.hpp"
 #include <cstddef>
+#include <vector>
 
 
 namespace mosqp
@@ -15,10 +16,19 @@ public:
 
     double GetF(Point const &point) const override;
     void GetG(Point const &point, double *g) const override;
+    void GetFunctionValues(double const *x, double *f, double *g) const override;
+    size_t GetVariant() const override;
 
 protected:
     size_t const objectiveIndex;
     MONLP const &monlp;
+    // The objective-value and the constraint-values of the last evaluations.
+    mutable LastEvaluation lastF;
+    mutable LastEvaluation lastG;
+    // Scratch space for the constraint part of the Hessian, so that evaluating it allocates
+    // nothing. Like "lastF" and "lastG" it is state of this object, so every thread that solves in
+    // parallel needs its own SingleMONLP.
+    mutable std::vector<double> d2gValues;
 
     double EvalF_impl(double const *x) const override;
     void EvalG_impl(double const *x, double *g) const override;
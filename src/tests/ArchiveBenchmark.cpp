@@ -0,0 +1,106 @@
+#include "Tests.hpp"
+#include "ObjectiveProblem.hpp"
+#include "../algorithm/DominanceArchive.hpp"
+#include "../algorithm/KdTreeArchive.hpp"
+#include "../algorithm/LinearArchive.hpp"
+#include "../algorithm/Point.hpp"
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+#include <random>
+#include <vector>
+
+
+namespace tests
+{
+
+using mosqp::DominanceArchive;
+using mosqp::Point;
+
+static size_t const NOT_REMOVED = static_cast<size_t>(-1);
+
+// Random points a bit above the part of the unit sphere with positive coordinates, so that many
+// of them are not dominated by each other. About every tenth point violates the constraint.
+static std::vector<Point> CreateSpherePoints(ObjectiveProblem const &problem, size_t const num_points,
+                                             std::mt19937 &random_engine)
+{
+    size_t const num_objectives = problem.GetNumObjectives();
+    std::uniform_real_distribution<double> uniform_distribution;
+    std::vector<Point> points;
+    points.reserve(num_points);
+    std::vector<double> f(num_objectives);
+    for (size_t i = 0; i < num_points; i += 1)
+    {
+        double norm = 0;
+        for (size_t k = 0; k < num_objectives; k += 1)
+        {
+            f[k] = uniform_distribution(random_engine);
+            norm += f[k] * f[k];
+        }
+        double const scale = (1 + 0.1 * uniform_distribution(random_engine)) / std::sqrt(norm);
+        for (size_t k = 0; k < num_objectives; k += 1)
+        {
+            f[k] *= scale;
+        }
+        double const violation = (uniform_distribution(random_engine) < 0.1) ? uniform_distribution(random_engine) : 0;
+        points.push_back(problem.CreatePoint(f, violation));
+    }
+    return points;
+}
+
+// Inserts the points in order, the slot of a point is its index. "removed_by[i]" is set to the
+// index of the point that removed point "i", or to "i" itself if the point was rejected.
+// Returns the seconds it took.
+static double InsertPoints(DominanceArchive &archive, std::vector<Point> const &points,
+                           std::vector<size_t> &removed_by)
+{
+    removed_by.assign(points.size(), NOT_REMOVED);
+    std::vector<size_t> dominated;
+    auto const start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < points.size(); i += 1)
+    {
+        if (archive.IsDominated(points[i]))
+        {
+            removed_by[i] = i;
+            continue;
+        }
+
+        dominated.clear();
+        archive.FindDominated(points[i], dominated);
+        for (size_t slot : dominated)
+        {
+            archive.Remove(slot, points[slot]);
+            removed_by[slot] = i;
+        }
+        archive.Insert(i, points[i]);
+    }
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+bool BenchmarkArchives(size_t const num_points, size_t const num_objectives)
+{
+    ObjectiveProblem const problem(num_objectives);
+    std::mt19937 random_engine(1);
+    std::vector<Point> const points = CreateSpherePoints(problem, num_points, random_engine);
+
+    mosqp::LinearArchive linear_archive(num_objectives);
+    std::vector<size_t> linear_removed_by;
+    double const linear_seconds = InsertPoints(linear_archive, points, linear_removed_by);
+
+    mosqp::KdTreeArchive tree_archive(num_objectives);
+    std::vector<size_t> tree_removed_by;
+    double const tree_seconds = InsertPoints(tree_archive, points, tree_removed_by);
+
+    std::cout << "BenchmarkArchives: " << num_objectives << " objectives, " << num_points << " inserts, "
+              << tree_archive.NumPoints() << " points left: linear " << linear_seconds << "s, k-d tree "
+              << tree_seconds << "s" << std::endl;
+    if (linear_removed_by != tree_removed_by || linear_archive.NumPoints() != tree_archive.NumPoints())
+    {
+        std::cout << "BenchmarkArchives: The archives rejected or removed different points!" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+} // namespace tests
@@ -0,0 +1,177 @@
+#include "Tests.hpp"
+#include "ObjectiveProblem.hpp"
+#include "../algorithm/BiObjectiveArchive.hpp"
+#include "../algorithm/DominanceArchive.hpp"
+#include "../algorithm/KdTreeArchive.hpp"
+#include "../algorithm/LinearArchive.hpp"
+#include "../algorithm/Point.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+
+namespace tests
+{
+
+using mosqp::DominanceArchive;
+using mosqp::Point;
+
+// Few distinct objective-values and violations, so that there are plenty of ties, equal points
+// and points with a violation right at the tolerance.
+static Point CreateRandomPoint(ObjectiveProblem const &problem, std::mt19937 &random_engine)
+{
+    std::uniform_int_distribution<int> value_distribution(0, 5);
+    std::uniform_int_distribution<int> violation_distribution(0, 9);
+    std::vector<double> f(problem.GetNumObjectives());
+    for (double &value : f)
+    {
+        value = value_distribution(random_engine);
+    }
+
+    double violation = 0;
+    switch (violation_distribution(random_engine))
+    {
+    case 0:
+        violation = Point::TOL_FEAS;
+        break;
+    case 1:
+        violation = 0.5 * Point::TOL_FEAS;
+        break;
+    case 2:
+        violation = 2 * Point::TOL_FEAS;
+        break;
+    case 3:
+        violation = 1.0;
+        break;
+    }
+    return problem.CreatePoint(f, violation);
+}
+
+// Compares both queries of the archive for the given point to "Point::IsDominated" over the
+// points the archive should hold, "points[slot]" for every slot marked in "stored".
+static bool CheckQueries(DominanceArchive const &archive, std::vector<Point> const &points,
+                         std::vector<bool> const &stored, Point const &point)
+{
+    bool is_dominated = false;
+    std::vector<size_t> expected_slots;
+    for (size_t slot = 0; slot < points.size(); slot += 1)
+    {
+        if (stored[slot])
+        {
+            is_dominated = is_dominated || point.IsDominated(points[slot]);
+            if (points[slot].IsDominated(point))
+            {
+                expected_slots.push_back(slot);
+            }
+        }
+    }
+
+    std::vector<size_t> slots;
+    archive.FindDominated(point, slots);
+    std::sort(slots.begin(), slots.end());
+    return archive.IsDominated(point) == is_dominated && slots == expected_slots;
+}
+
+// Inserts and removes random points and checks the queries for random points after every change,
+// also for a copy of the archive and for a lower tolerance than the points were inserted with.
+static bool CheckArchive(DominanceArchive &archive, ObjectiveProblem const &problem, std::string const &name)
+{
+    std::mt19937 random_engine(1);
+    std::uniform_int_distribution<int> operation_distribution(0, 2);
+    std::vector<Point> points;
+    std::vector<bool> stored;
+    for (int round = 0; round < 2000; round += 1)
+    {
+        std::vector<size_t> stored_slots;
+        for (size_t slot = 0; slot < stored.size(); slot += 1)
+        {
+            if (stored[slot])
+            {
+                stored_slots.push_back(slot);
+            }
+        }
+
+        if (round == 1000)
+        {
+            archive.Clear();
+            std::fill(stored.begin(), stored.end(), false);
+        }
+        else if (operation_distribution(random_engine) == 0 && !stored_slots.empty())
+        {
+            size_t const slot = stored_slots[random_engine() % stored_slots.size()];
+            archive.Remove(slot, points[slot]);
+            stored[slot] = false;
+        }
+        else
+        {
+            // reuses a free slot if there is one, like "ParetoFront" does
+            size_t slot = std::find(stored.begin(), stored.end(), false) - stored.begin();
+            if (slot == points.size())
+            {
+                points.push_back(CreateRandomPoint(problem, random_engine));
+                stored.push_back(false);
+            }
+            else
+            {
+                points[slot] = CreateRandomPoint(problem, random_engine);
+            }
+            archive.Insert(slot, points[slot]);
+            stored[slot] = true;
+        }
+
+        for (int query = 0; query < 5; query += 1)
+        {
+            Point const point = CreateRandomPoint(problem, random_engine);
+            if (!CheckQueries(archive, points, stored, point))
+            {
+                std::cout << "CheckArchives: " << name << " disagrees with Point::IsDominated in round "
+                          << round << "!" << std::endl;
+                return false;
+            }
+        }
+
+        if (round % 100 == 0)
+        {
+            std::unique_ptr<DominanceArchive> const clone = archive.Clone();
+            double const tolerance = Point::TOL_FEAS;
+            Point::TOL_FEAS = 0.25 * tolerance;
+            Point const point = CreateRandomPoint(problem, random_engine);
+            bool const correct = CheckQueries(*clone, points, stored, point) &&
+                                 CheckQueries(archive, points, stored, point);
+            Point::TOL_FEAS = tolerance;
+            if (!correct)
+            {
+                std::cout << "CheckArchives: " << name << " disagrees with Point::IsDominated after lowering "
+                          << "the tolerance in round " << round << "!" << std::endl;
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool CheckArchives()
+{
+    bool passed = true;
+    for (size_t num_objectives = 2; num_objectives <= 4; num_objectives += 1)
+    {
+        ObjectiveProblem const problem(num_objectives);
+        std::string const suffix = " with " + std::to_string(num_objectives) + " objectives";
+        mosqp::LinearArchive linear_archive(num_objectives);
+        passed = CheckArchive(linear_archive, problem, "LinearArchive" + suffix) && passed;
+        mosqp::KdTreeArchive kd_tree_archive(num_objectives);
+        passed = CheckArchive(kd_tree_archive, problem, "KdTreeArchive" + suffix) && passed;
+        if (num_objectives == 2)
+        {
+            mosqp::BiObjectiveArchive bi_objective_archive;
+            passed = CheckArchive(bi_objective_archive, problem, "BiObjectiveArchive") && passed;
+        }
+    }
+    return passed;
+}
+
+} // namespace tests
@@ -0,0 +1,120 @@
+#include "Tests.hpp"
+#include "../problem_formulation/CombinedMONLP.hpp"
+#include "../problem_formulation/MatrixStructure.hpp"
+#include "../problem_formulation/MONLP.hpp"
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+
+namespace tests
+{
+
+using mosqp::MatrixStructure;
+
+// Three nonlinear objectives and two constraints, so that rounding would show if the joint
+// evaluation computed anything differently.
+class WaveProblem : public mosqp::MONLP
+{
+public:
+    WaveProblem() : MONLP(
+        3,  // number of variables
+        2,  // number of constraints
+        3,  // number of objectives
+
+        std::vector<MatrixStructure>(3, MatrixStructure(false)),  // structures of df
+        MatrixStructure(false),                                   // structure of dg
+        std::vector<MatrixStructure>(3, MatrixStructure(false)),  // structures of hm
+        false, false, false,  // no user derivatives
+
+        { -3.0, -3.0, -3.0 },  // lower bounds on x
+        { 3.0, 3.0, 3.0 },     // upper bounds on x
+        { -1.0, 0.0 },         // lower bounds on g
+        { 1.0, 4.0 })          // upper bounds on g
+    {
+    }
+
+    std::string GetName() const override { return "WaveProblem"; }
+
+private:
+    double EvalF_impl(double const *const x, size_t const objective_index) const override
+    {
+        return std::sin(x[objective_index]) * std::exp(0.3 * x[(objective_index + 1) % 3]) + x[2] * x[2];
+    }
+
+    void EvalG_impl(double const *const x, double *const g) const override
+    {
+        g[0] = std::cos(x[0] * x[1]);
+        g[1] = x[0] * x[0] + x[1] * x[1] + x[2] * x[2];
+    }
+};
+
+// Whether "EvalFG" gives bit-identical values to "EvalF" and "EvalG" of both problems at "x", in
+// either order, i.e. whether WORHP sees the same values with and without "FGtogether".
+static bool IsJointEvaluationEqual(WaveProblem const &problem, mosqp::CombinedMONLP const &combined_problem,
+                                   std::vector<double> const &x)
+{
+    size_t const num_objectives = problem.GetNumObjectives();
+    std::vector<double> f(num_objectives);
+    std::vector<double> g(problem.GetNumConstraints());
+    std::vector<double> joint_f(num_objectives);
+    std::vector<double> joint_g(problem.GetNumConstraints());
+    problem.EvalF(x.data(), f.data());
+    problem.EvalG(x.data(), g.data());
+    problem.EvalFG(x.data(), joint_f.data(), joint_g.data());
+    if (f != joint_f || g != joint_g)
+    {
+        return false;
+    }
+
+    std::vector<double> combined_g(combined_problem.GetNumConstraints());
+    std::vector<double> joint_combined_g(combined_problem.GetNumConstraints());
+    double const joint_combined_f = combined_problem.EvalFG(x.data(), joint_combined_g.data());
+    double const combined_f = combined_problem.EvalF(x.data());
+    combined_problem.EvalG(x.data(), combined_g.data());
+    return combined_f == joint_combined_f && combined_g == joint_combined_g;
+}
+
+bool CheckJointEvaluation()
+{
+    WaveProblem problem;
+    std::mt19937 random_engine(1);
+    std::uniform_real_distribution<double> distribution(-3.0, 3.0);
+    for (int cached = 0; cached < 2; cached += 1)
+    {
+        if (cached == 1)
+        {
+            problem.EnableCache(16);
+        }
+
+        mosqp::CombinedMONLP combined_problem(problem, { 1.0, 0.5, 2.0 });
+        for (int round = 0; round < 200; round += 1)
+        {
+            if (round % 10 == 0)
+            {
+                combined_problem.SetParameters({ distribution(random_engine), distribution(random_engine),
+                                                 distribution(random_engine) });
+            }
+
+            // a few points come again, so that both the cache and the last values get used
+            std::vector<double> x(combined_problem.GetNumVariables());
+            std::mt19937 point_engine(random_engine() % 20);
+            for (double &value : x)
+            {
+                value = distribution(point_engine);
+            }
+            if (!IsJointEvaluationEqual(problem, combined_problem, x))
+            {
+                std::cout << "CheckJointEvaluation: EvalFG differs from EvalF and EvalG in round " << round
+                          << (cached == 1 ? " with" : " without") << " the cache!" << std::endl;
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+} // namespace tests
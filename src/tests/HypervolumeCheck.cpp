@@ -0,0 +1,138 @@
+#include "Tests.hpp"
+#include "../algorithm/Hypervolume.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+#include <random>
+#include <vector>
+
+
+namespace tests
+{
+
+// Exclusive contributions by splitting the box below the reference point into the cells between
+// all coordinates of the points and giving each cell to the only point dominating it, if any.
+// Takes O(n^4).
+static std::vector<double> ComputeExclusiveHypervolumesBruteForce(std::vector<std::array<double, 3>> const &points,
+                                                                  std::array<double, 3> const &reference)
+{
+    std::array<std::vector<double>, 3> coordinates;
+    for (size_t k = 0; k < 3; k += 1)
+    {
+        for (std::array<double, 3> const &point : points)
+        {
+            coordinates[k].push_back(std::min(point[k], reference[k]));
+        }
+        coordinates[k].push_back(reference[k]);
+        std::sort(coordinates[k].begin(), coordinates[k].end());
+        coordinates[k].erase(std::unique(coordinates[k].begin(), coordinates[k].end()), coordinates[k].end());
+    }
+
+    std::vector<double> contributions(points.size(), 0.0);
+    for (size_t a = 0; a + 1 < coordinates[0].size(); a += 1)
+    {
+        for (size_t b = 0; b + 1 < coordinates[1].size(); b += 1)
+        {
+            for (size_t c = 0; c + 1 < coordinates[2].size(); c += 1)
+            {
+                size_t num_dominating = 0;
+                size_t dominating = 0;
+                for (size_t i = 0; i < points.size(); i += 1)
+                {
+                    if (points[i][0] <= coordinates[0][a] && points[i][1] <= coordinates[1][b] &&
+                        points[i][2] <= coordinates[2][c])
+                    {
+                        num_dominating += 1;
+                        dominating = i;
+                    }
+                }
+                if (num_dominating == 1)
+                {
+                    contributions[dominating] += (coordinates[0][a + 1] - coordinates[0][a]) *
+                                                 (coordinates[1][b + 1] - coordinates[1][b]) *
+                                                 (coordinates[2][c + 1] - coordinates[2][c]);
+                }
+            }
+        }
+    }
+    return contributions;
+}
+
+static bool AreClose(std::vector<double> const &values, std::vector<double> const &expected)
+{
+    for (size_t i = 0; i < values.size(); i += 1)
+    {
+        if (std::abs(values[i] - expected[i]) > 1e-9 * (1 + std::abs(expected[i])))
+        {
+            return false;
+        }
+    }
+    return values.size() == expected.size();
+}
+
+bool CheckHypervolume()
+{
+    std::mt19937 random_engine(1);
+    // few distinct values, so that there are plenty of ties, equal and dominated points
+    std::uniform_int_distribution<int> value_distribution(0, 8);
+    std::uniform_int_distribution<size_t> size_distribution(1, 25);
+    std::array<double, 3> const reference = { 7.5, 8.0, 7.0 };
+    for (int round = 0; round < 300; round += 1)
+    {
+        std::vector<std::array<double, 3>> points(size_distribution(random_engine));
+        for (std::array<double, 3> &point : points)
+        {
+            for (double &value : point)
+            {
+                value = 0.5 * value_distribution(random_engine);
+            }
+        }
+        // also the order "sorted" expects, which has to give the same
+        if (round % 2 == 1)
+        {
+            std::sort(points.begin(), points.end(),
+                      [](std::array<double, 3> const &a, std::array<double, 3> const &b) { return a[2] < b[2]; });
+        }
+
+        std::vector<double const *> point_data;
+        for (std::array<double, 3> const &point : points)
+        {
+            point_data.push_back(point.data());
+        }
+        std::vector<double> const expected = ComputeExclusiveHypervolumesBruteForce(points, reference);
+        std::vector<double> contributions;
+        mosqp::ComputeExclusiveHypervolumes3D(point_data, reference.data(), contributions, round % 2 == 1);
+        if (!AreClose(contributions, expected))
+        {
+            std::cout << "CheckHypervolume: Wrong contributions of " << points.size() << " points!" << std::endl;
+            return false;
+        }
+
+        // removing a point grows the contributions of the others by the increases
+        size_t const removed = round % points.size();
+        std::vector<std::array<double, 3>> others(points);
+        others.erase(others.begin() + removed);
+        std::vector<double const *> other_data(point_data);
+        other_data.erase(other_data.begin() + removed);
+        std::vector<double> const expected_after = ComputeExclusiveHypervolumesBruteForce(others, reference);
+        std::vector<double> expected_increases;
+        for (size_t i = 0; i < others.size(); i += 1)
+        {
+            expected_increases.push_back(expected_after[i] - expected[(i < removed) ? i : i + 1]);
+        }
+        std::vector<double> increases;
+        mosqp::ComputeHypervolumeIncreases3D(points[removed].data(), other_data, reference.data(), increases,
+                                             round % 2 == 1);
+        if (!AreClose(increases, expected_increases))
+        {
+            std::cout << "CheckHypervolume: Wrong increases after removing one of " << points.size() << " points!"
+                      << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace tests
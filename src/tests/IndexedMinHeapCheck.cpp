@@ -0,0 +1,80 @@
+#include "Tests.hpp"
+#include "../algorithm/IndexedMinHeap.hpp"
+#include <cstddef>
+#include <iostream>
+#include <random>
+#include <vector>
+
+
+namespace tests
+{
+
+static size_t const NO_ID = static_cast<size_t>(-1);
+
+// The id "IndexedMinHeap::Top" should return, found by looking at all keys.
+static size_t FindSmallest(std::vector<bool> const &contained, std::vector<double> const &keys)
+{
+    size_t smallest = NO_ID;
+    for (size_t id = 0; id < keys.size(); id += 1)
+    {
+        if (contained[id] && (smallest == NO_ID || keys[id] < keys[smallest]))
+        {
+            smallest = id;
+        }
+    }
+    return smallest;
+}
+
+bool CheckIndexedMinHeap()
+{
+    std::mt19937 random_engine(1);
+    // few distinct keys, so that the tie-breaking by id matters
+    std::uniform_int_distribution<int> key_distribution(0, 9);
+    std::uniform_int_distribution<int> operation_distribution(0, 3);
+    size_t const num_ids = 64;
+    mosqp::IndexedMinHeap heap;
+    std::vector<bool> contained(num_ids, false);
+    std::vector<double> keys(num_ids, 0.0);
+    for (int round = 0; round < 20000; round += 1)
+    {
+        size_t const id = random_engine() % num_ids;
+        double const key = key_distribution(random_engine);
+        int const operation = operation_distribution(random_engine);
+        if (round % 5000 == 4999)
+        {
+            heap.Clear();
+            contained.assign(num_ids, false);
+        }
+        else if (operation == 0 && !heap.IsEmpty())
+        {
+            contained[heap.Top()] = false;
+            heap.Pop();
+        }
+        else if (contained[id])
+        {
+            heap.Update(id, key);
+            keys[id] = key;
+        }
+        else
+        {
+            heap.Push(id, key);
+            contained[id] = true;
+            keys[id] = key;
+        }
+
+        size_t const smallest = FindSmallest(contained, keys);
+        bool correct = (heap.IsEmpty() == (smallest == NO_ID)) && (heap.IsEmpty() || heap.Top() == smallest);
+        for (size_t other_id = 0; other_id < num_ids; other_id += 1)
+        {
+            correct = correct && (heap.Contains(other_id) == contained[other_id]);
+        }
+        if (!correct)
+        {
+            std::cout << "CheckIndexedMinHeap: Wrong heap after round " << round << "!" << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace tests
@@ -0,0 +1,114 @@
+#include "Tests.hpp"
+#include "../problem_formulation/MatrixStructure.hpp"
+#include <cstddef>
+#include <iostream>
+#include <random>
+#include <set>
+#include <utility>
+#include <vector>
+
+
+namespace tests
+{
+
+using mosqp::MatrixStructure;
+
+// Whether the structure holds exactly the given entries, sorted by column and row, followed by
+// the first "num_special_diag" diagonal entries, and whether "FindEntry" finds each of them and
+// nothing else.
+static bool IsStructureCorrect(MatrixStructure const &structure, std::set<std::pair<size_t, size_t>> const &entries,
+                               size_t const num_special_diag, size_t const size)
+{
+    std::vector<size_t> const row(structure.GetRowBegin(), structure.GetRowEnd());
+    std::vector<size_t> const col(structure.GetColBegin(), structure.GetColEnd());
+    if (structure.GetNumNonZeros() != entries.size() + num_special_diag || row.size() != col.size() ||
+        row.size() != structure.GetNumNonZeros() || !structure.HasColPointers())
+    {
+        return false;
+    }
+
+    // the set is ordered by (column, row) already
+    size_t position = 0;
+    for (std::pair<size_t, size_t> const &entry : entries)
+    {
+        if (col[position] != entry.first || row[position] != entry.second)
+        {
+            return false;
+        }
+        position += 1;
+    }
+    for (size_t i = 1; i <= num_special_diag; i += 1)
+    {
+        if (row[position] != i || col[position] != i)
+        {
+            return false;
+        }
+        position += 1;
+    }
+
+    for (size_t c = 1; c <= size + 1; c += 1)
+    {
+        for (size_t r = 1; r <= size + 1; r += 1)
+        {
+            bool const special = (r == c && r <= num_special_diag);
+            size_t const found = structure.FindEntry(r, c);
+            if (special || entries.count(std::make_pair(c, r)) != 0)
+            {
+                if (found == MatrixStructure::NO_ENTRY || row[found] != r || col[found] != c)
+                {
+                    return false;
+                }
+            }
+            else if (found != MatrixStructure::NO_ENTRY)
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool CheckMatrixStructure()
+{
+    std::mt19937 random_engine(1);
+    for (int round = 0; round < 500; round += 1)
+    {
+        size_t const size = 1 + random_engine() % 8;
+        size_t const num_special_diag = (round % 2 == 0) ? 0 : 1 + random_engine() % size;
+        size_t const num_entries = random_engine() % (2 * size * size);
+        MatrixStructure::Builder builder(num_special_diag);
+        // entries as (column, row)
+        std::set<std::pair<size_t, size_t>> entries;
+        for (size_t i = 0; i < num_entries; i += 1)
+        {
+            size_t const row = 1 + random_engine() % size;
+            size_t const col = 1 + random_engine() % size;
+            builder.AddEntry(row, col);
+            if (row != col || col > num_special_diag)
+            {
+                entries.emplace(col, row);
+            }
+        }
+
+        MatrixStructure const structure = builder.Build();
+        if (!IsStructureCorrect(structure, entries, num_special_diag, size))
+        {
+            std::cout << "CheckMatrixStructure: Wrong structure from the builder in round " << round << "!"
+                      << std::endl;
+            return false;
+        }
+
+        // adding the entries of a structure to another builder gives the same structure again
+        MatrixStructure::Builder copy_builder(num_special_diag);
+        copy_builder.AddEntries(structure);
+        if (!IsStructureCorrect(copy_builder.Build(), entries, num_special_diag, size))
+        {
+            std::cout << "CheckMatrixStructure: Wrong structure from copying in round " << round << "!"
+                      << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace tests
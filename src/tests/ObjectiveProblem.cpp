@@ -0,0 +1,53 @@
+#include "ObjectiveProblem.hpp"
+#include "../algorithm/ArrayView.hpp"
+#include "../algorithm/Point.hpp"
+#include "../problem_formulation/MatrixStructure.hpp"
+#include "../problem_formulation/MONLP.hpp"
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+
+namespace tests
+{
+
+using mosqp::MatrixStructure;
+
+double constexpr POS_INF = std::numeric_limits<double>::infinity();
+double constexpr NEG_INF = -POS_INF;
+
+ObjectiveProblem::ObjectiveProblem(size_t const num_objectives) : MONLP(
+    num_objectives + 1,  // number of variables
+    1,                   // number of constraints
+    num_objectives,      // number of objectives
+
+    std::vector<MatrixStructure>(num_objectives, MatrixStructure(false)),  // structures of df
+    MatrixStructure(false),                                                // structure of dg
+    std::vector<MatrixStructure>(num_objectives, MatrixStructure(false)),  // structures of hm
+    false, false, false,  // no user derivatives
+
+    std::vector<double>(num_objectives + 1, NEG_INF),  // lower bounds on x
+    std::vector<double>(num_objectives + 1, POS_INF),  // upper bounds on x
+    { NEG_INF },                                       // lower bounds on g
+    { 0 })                                             // upper bounds on g
+{
+}
+
+mosqp::Point ObjectiveProblem::CreatePoint(std::vector<double> const &f, double const max_violation) const
+{
+    std::vector<double> x(f);
+    x.push_back(max_violation);
+    return mosqp::Point(x, *this);
+}
+
+double ObjectiveProblem::EvalF_impl(double const *const x, size_t const objective_index) const
+{
+    return x[objective_index];
+}
+
+void ObjectiveProblem::EvalG_impl(double const *const x, double *const g) const
+{
+    g[0] = x[numObjectives];
+}
+
+} // namespace tests
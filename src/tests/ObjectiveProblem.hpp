@@ -0,0 +1,29 @@
+#pragma once
+
+#include "../algorithm/Point.hpp"
+#include "../problem_formulation/MONLP.hpp"
+#include <cstddef>
+#include <string>
+#include <vector>
+
+
+namespace tests
+{
+
+// Problem whose objective-values are its first variables and whose only constraint keeps its last
+// variable at or below zero, so that the checks can build points with any objective-values and
+// maximum violation.
+class ObjectiveProblem : public mosqp::MONLP
+{
+public:
+    ObjectiveProblem(size_t num_objectives);
+    std::string GetName() const override { return "ObjectiveProblem"; }
+
+    mosqp::Point CreatePoint(std::vector<double> const &f, double max_violation) const;
+
+private:
+    double EvalF_impl(double const *x, size_t objective_index) const override;
+    void EvalG_impl(double const *x, double *g) const override;
+};
+
+} // namespace tests
@@ -0,0 +1,113 @@
+#include "Tests.hpp"
+#include "ObjectiveProblem.hpp"
+#include "../algorithm/ParetoFront.hpp"
+#include "../algorithm/Point.hpp"
+#include <cstddef>
+#include <iostream>
+#include <random>
+#include <vector>
+
+
+namespace tests
+{
+
+using mosqp::ParetoFront;
+
+// A handle together with the objective-values of its point and whether the point left the front.
+struct HandleEntry
+{
+    ParetoFront::PointHandle handle;
+    std::vector<double> f;
+    bool removed;
+};
+
+// Whether every handle finds its own point as long as it is in the front and nothing afterwards,
+// and whether the handles of the points still in the front cover all of them. Marks the handles
+// whose points left the front as removed.
+static bool AreHandlesCorrect(ParetoFront const &front, std::vector<HandleEntry> &entries)
+{
+    size_t num_found = 0;
+    for (HandleEntry &entry : entries)
+    {
+        std::vector<mosqp::Point>::const_iterator const it = front.Find(entry.handle);
+        if (it == front.end())
+        {
+            entry.removed = true;
+        }
+        else if (entry.removed || it->GetObjectiveValues().ToVector() != entry.f)
+        {
+            return false;
+        }
+        else
+        {
+            num_found += 1;
+        }
+    }
+    return num_found == front.NumPoints();
+}
+
+bool CheckPointHandles()
+{
+    size_t const num_objectives = 3;
+    ObjectiveProblem const problem(num_objectives);
+    std::mt19937 random_engine(1);
+    std::uniform_int_distribution<int> value_distribution(0, 9);
+    std::uniform_int_distribution<int> operation_distribution(0, 3);
+    // never truncated, points only leave the front when they are dominated or removed
+    ParetoFront front(1000000, num_objectives, {});
+    std::vector<HandleEntry> entries;
+    for (int round = 0; round < 5000; round += 1)
+    {
+        int const operation = operation_distribution(random_engine);
+        if (operation == 0 && front.NumPoints() != 0)
+        {
+            front.RemovePoint(front.begin() + random_engine() % front.NumPoints());
+        }
+        else
+        {
+            // a single point or a batch of up to four points
+            size_t const num_new = (operation == 1) ? 1 + random_engine() % 4 : 1;
+            std::vector<std::vector<double>> new_f(num_new, std::vector<double>(num_objectives));
+            std::vector<mosqp::Point> new_points;
+            for (std::vector<double> &f : new_f)
+            {
+                for (double &value : f)
+                {
+                    value = value_distribution(random_engine);
+                }
+                new_points.push_back(problem.CreatePoint(f, 0.0));
+            }
+
+            std::vector<ParetoFront::PointHandle> handles;
+            if (operation == 1)
+            {
+                front.AddPoints(std::move(new_points), handles);
+            }
+            else
+            {
+                handles.push_back(front.AddPoint(std::move(new_points.front())));
+            }
+            for (size_t i = 0; i < num_new; i += 1)
+            {
+                entries.push_back(HandleEntry{ handles[i], new_f[i], false });
+            }
+        }
+
+        if (!AreHandlesCorrect(front, entries))
+        {
+            std::cout << "CheckPointHandles: Wrong point found by a handle in round " << round << "!" << std::endl;
+            return false;
+        }
+    }
+
+    // the handles stay valid for a copy of the front
+    ParetoFront const copy(front);
+    if (!AreHandlesCorrect(copy, entries))
+    {
+        std::cout << "CheckPointHandles: Wrong point found by a handle in the copy of the front!" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+} // namespace tests
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+
+
+// Checks and benchmarks of single parts of MOSQP, run by the tests project with "main.cpp" of
+// this directory. They print what went wrong and return whether everything was right.
+namespace tests
+{
+
+// Compares the exclusive hypervolume contributions and their increases after a removal in three
+// objectives to those of a brute force over small random point sets with many ties.
+bool CheckHypervolume();
+
+// Solves a small problem from the same initial points with one and with four threads and checks
+// that both give the same front, i.e. that no solve depends on which thread ran it.
+bool CheckThreadIndependence();
+
+// Checks that "EvalFG" of a problem and of the combined problem of the refine stage gives the
+// same values as "EvalF" and "EvalG", with and without the evaluation cache, so that enabling
+// "FGtogether" in "worhp.xml" does not change what WORHP computes.
+bool CheckJointEvaluation();
+
+// Inserts and removes random points with many ties into every archive and compares "IsDominated"
+// and "FindDominated" to "Point::IsDominated" over all stored points, including infeasible points
+// and points with a violation right at the tolerance.
+bool CheckArchives();
+
+// Adds single points and batches to a "ParetoFront", removes random points and checks that every
+// handle finds its point until the point leaves the front, and nothing afterwards even if its
+// slot is reused.
+bool CheckPointHandles();
+
+// Runs random pushes, updates and pops on an "IndexedMinHeap" and compares the top to the
+// smallest key found by looking at all of them.
+bool CheckIndexedMinHeap();
+
+// Builds random structures and checks their order, the special diagonal and "FindEntry" for
+// every position.
+bool CheckMatrixStructure();
+
+// Inserts "num_points" random points with "num_objectives" objectives into a "LinearArchive" and
+// a "KdTreeArchive" the way "ParetoFront" does, i.e. a point goes in if no point of the archive
+// dominates it and the points it dominates are removed. Prints the time each archive took and
+// checks that both rejected and removed the same points.
+bool BenchmarkArchives(size_t num_points, size_t num_objectives);
+
+} // namespace tests
@@ -0,0 +1,102 @@
+#include "Tests.hpp"
+#include "../algorithm/MOSQP.hpp"
+#include "../algorithm/ParetoFront.hpp"
+#include "../algorithm/Point.hpp"
+#include "../problem_formulation/MatrixStructure.hpp"
+#include "../problem_formulation/MONLP.hpp"
+#include <cstddef>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+
+namespace tests
+{
+
+using mosqp::MatrixStructure;
+
+// Two distances to minimise with a linear constraint that cuts off part of the front, small
+// enough for the check to solve it twice.
+class DistanceProblem : public mosqp::MONLP
+{
+public:
+    DistanceProblem() : MONLP(
+        2,  // number of variables
+        1,  // number of constraints
+        2,  // number of objectives
+
+        { MatrixStructure(false), MatrixStructure(false) },  // structures of df
+        MatrixStructure(false),                              // structure of dg
+        { MatrixStructure(false), MatrixStructure(false) },  // structures of hm
+        false, false, false,  // no user derivatives
+
+        { -5.0, -5.0 },  // lower bounds on x
+        { 10.0, 10.0 },  // upper bounds on x
+        { -20.0 },       // lower bounds on g
+        { 7.0 })         // upper bounds on g
+    {
+    }
+
+    std::string GetName() const override { return "DistanceProblem"; }
+
+private:
+    double EvalF_impl(double const *const x, size_t const objective_index) const override
+    {
+        double const center = (objective_index == 0) ? 0.0 : 5.0;
+        return (x[0] - center) * (x[0] - center) + (x[1] - center) * (x[1] - center);
+    }
+
+    void EvalG_impl(double const *const x, double *const g) const override
+    {
+        g[0] = x[0] + x[1];
+    }
+};
+
+// Solves from the same initial points with the given number of threads and returns the
+// objective-values of the front in its order.
+static std::vector<std::vector<double>> SolveFront(DistanceProblem &problem, std::vector<mosqp::Point> const &points,
+                                                   mosqp::Parameters parameters, int const num_threads)
+{
+    parameters.numThreads = num_threads;
+    mosqp::MOSQP mosqp(problem, points, parameters);
+    mosqp::ParetoFront const front = mosqp.Solve();
+    std::vector<std::vector<double>> objective_values;
+    for (mosqp::Point const &point : front)
+    {
+        objective_values.push_back(point.GetObjectiveValues().ToVector());
+    }
+    return objective_values;
+}
+
+bool CheckThreadIndependence()
+{
+    DistanceProblem problem;
+    std::mt19937 random_engine(1);
+    std::uniform_real_distribution<double> distribution(-5.0, 10.0);
+    std::vector<mosqp::Point> points;
+    for (int i = 0; i < 12; i += 1)
+    {
+        std::vector<double> const x = { distribution(random_engine), distribution(random_engine) };
+        points.emplace_back(x, problem);
+    }
+
+    mosqp::Parameters parameters;
+    parameters.maxPoints = 30;
+    // only the given points, the random ones would differ between the runs
+    parameters.numCompletionTries = 0;
+    parameters.SPREAD_MAX_STEPS = 4;
+    parameters.REFINE_MAX_STEPS = 3;
+
+    std::vector<std::vector<double>> const serial_front = SolveFront(problem, points, parameters, 1);
+    std::vector<std::vector<double>> const parallel_front = SolveFront(problem, points, parameters, 4);
+    if (serial_front != parallel_front)
+    {
+        std::cout << "CheckThreadIndependence: The front of 4 threads differs from the one of 1 thread!"
+                  << std::endl;
+        return false;
+    }
+    return true;
+}
+
+} // namespace tests
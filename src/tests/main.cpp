@@ -0,0 +1,40 @@
+#include "Tests.hpp"
+#include "../algorithm/MOSQP.hpp"
+#include "../algorithm/Point.hpp"
+#include <cstddef>
+#include <iostream>
+#include <string>
+
+
+// Runs the checks, or the benchmarks with "benchmark [number of points]" as arguments.
+// Returns 1 if any of them failed.
+int main(int argc, char *argv[])
+{
+    // the archives depend on the tolerances, use those MOSQP uses by default
+    mosqp::Parameters const parameters;
+    mosqp::Point::TOL_FEAS = parameters.TOL_FEAS;
+    mosqp::Point::TOL_DOMINATION = parameters.TOL_DOMINATION;
+
+    bool passed = true;
+    if (argc > 1 && std::string(argv[1]) == "benchmark")
+    {
+        size_t const num_points = (argc > 2) ? std::stoul(argv[2]) : 20000;
+        for (size_t num_objectives = 3; num_objectives <= 5; num_objectives += 1)
+        {
+            passed = tests::BenchmarkArchives(num_points, num_objectives) && passed;
+        }
+    }
+    else
+    {
+        passed = tests::CheckHypervolume() && passed;
+        passed = tests::CheckThreadIndependence() && passed;
+        passed = tests::CheckJointEvaluation() && passed;
+        passed = tests::CheckArchives() && passed;
+        passed = tests::CheckPointHandles() && passed;
+        passed = tests::CheckIndexedMinHeap() && passed;
+        passed = tests::CheckMatrixStructure() && passed;
+    }
+
+    std::cout << (passed ? "All passed." : "FAILED!") << std::endl;
+    return passed ? 0 : 1;
+}